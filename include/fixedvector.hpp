@@ -0,0 +1,588 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <utility>
+
+#include <staticvector.hpp>
+
+namespace staticvec {
+
+// Header placed at the start of a FixedVector buffer. It only holds counts, so
+// the buffer stays valid when mapped at different addresses, e.g. by several
+// processes sharing it through shm_open/mmap.
+struct FixedVectorHeader {
+    std::uint64_t capacity;
+    std::uint64_t size;
+    std::uint64_t element_size;
+};
+
+namespace detail {
+
+[[noreturn, gnu::cold, gnu::noinline]]
+inline void invalid_argument(const char *what)
+{
+#if defined(__cpp_exceptions) && \
+    STATICVEC_OVERFLOW_POLICY == STATICVEC_OVERFLOW_THROW
+    throw std::invalid_argument(what);
+#else
+    (void)what;
+    std::abort();
+#endif
+}
+
+} // namespace detail
+
+} // namespace staticvec
+
+// Vector like container managing a caller supplied buffer instead of in-object
+// storage. A FixedVector is a non-owning handle: copying it yields another
+// handle to the same elements and destroying it leaves the elements alone.
+// Mutations must be synchronized by the caller.
+template<typename T>
+class FixedVector {
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr std::size_t alignment =
+        std::max(alignof(staticvec::FixedVectorHeader), alignof(T));
+
+    // Offset of the first element from the start of the buffer
+    static constexpr std::size_t data_offset =
+        (sizeof(staticvec::FixedVectorHeader) + alignof(T) - 1) /
+        alignof(T) * alignof(T);
+
+    static constexpr std::size_t storage_size(std::size_t capacity)
+    {
+        return data_offset + capacity * sizeof(T);
+    }
+
+    FixedVector()
+        : _header(nullptr)
+    {
+
+    }
+
+    // Lay out an empty vector in the given buffer, which must be aligned to
+    // FixedVector<T>::alignment.
+    static FixedVector<T> create(void *mem, std::size_t bytes)
+    {
+        check_alignment(mem);
+
+        if (bytes < data_offset) {
+            staticvec::detail::invalid_argument("FixedVector buffer too small");
+        }
+
+        auto *header = ::new (mem) staticvec::FixedVectorHeader;
+        header->capacity = (bytes - data_offset) / sizeof(T);
+        header->size = 0;
+        header->element_size = sizeof(T);
+
+        return FixedVector<T>(header);
+    }
+
+    // Open a vector previously laid out by create(), possibly by another
+    // process mapping the same memory.
+    static FixedVector<T> attach(void *mem)
+    {
+        check_alignment(mem);
+
+        auto *header = std::launder(
+            reinterpret_cast<staticvec::FixedVectorHeader *>(mem));
+
+        if (header->element_size != sizeof(T)) {
+            staticvec::detail::invalid_argument("FixedVector element size mismatch");
+        }
+
+        return FixedVector<T>(header);
+    }
+
+    bool valid() const
+    {
+        return _header != nullptr;
+    }
+
+    void assign(std::size_t count, const T& value)
+    {
+        clear();
+        insert(end(), count, value);
+    }
+
+    template<std::input_iterator InputIT>
+    void assign(InputIT first, InputIT last)
+    {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(std::initializer_list<T> ilist)
+    {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template<staticvec::detail::container_compatible_range<T> R>
+    void assign_range(R&& rg)
+    {
+        clear();
+        append_range(std::forward<R>(rg));
+    }
+
+    std::size_t size() const
+    {
+        return _header->size;
+    }
+
+    std::size_t max_size() const
+    {
+        return _header->capacity;
+    }
+
+    std::size_t capacity() const
+    {
+        return _header->capacity;
+    }
+
+    bool empty() const
+    {
+        return _header->size == 0;
+    }
+
+    T& operator[](std::size_t i)
+    {
+        if constexpr (staticvec::detail::check_enabled(STATICVEC_INDEX_CHECK)) {
+            if (i >= size()) [[unlikely]] {
+                staticvec::detail::out_of_range("FixedVector::operator[]");
+            }
+        }
+
+        return data()[i];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return const_cast<FixedVector<T> *>(this)->operator[](i);
+    }
+
+    T& at(std::size_t i)
+    {
+        if constexpr (staticvec::detail::check_enabled(STATICVEC_AT_CHECK)) {
+            if (i >= size()) [[unlikely]] {
+                staticvec::detail::out_of_range("FixedVector::at");
+            }
+        }
+
+        return data()[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        return const_cast<FixedVector<T> *>(this)->at(i);
+    }
+
+    T& front()
+    {
+        return this->at(0);
+    }
+
+    const T& front() const
+    {
+        return const_cast<FixedVector<T> *>(this)->front();
+    }
+
+    T& back()
+    {
+        // range check will catch the underflow
+        return this->at(size() - 1);
+    }
+
+    const T& back() const
+    {
+        return const_cast<FixedVector<T> *>(this)->back();
+    }
+
+    T* data()
+    {
+        return std::launder(reinterpret_cast<T *>(
+            reinterpret_cast<std::byte *>(_header) + data_offset));
+    }
+
+    const T* data() const
+    {
+        return const_cast<FixedVector<T> *>(this)->data();
+    }
+
+    // Uninitialized storage past the last element, e.g. to read() into.
+    // Written elements become part of the vector with commit().
+    std::span<T> spare_capacity() requires staticvec::detail::overwritable<T>
+    {
+        return std::span<T>(end(), capacity() - size());
+    }
+
+    // Append the first n elements of spare_capacity() without initializing them
+    void commit(std::size_t n) requires staticvec::detail::overwritable<T>
+    {
+        _header->size += room_for(n, "commit past FixedVector size");
+    }
+
+    // Set size() to n. Elements past the old size are left uninitialized, which
+    // is only allowed for trivially default constructible and copyable T;
+    // shrinking just drops the trailing elements.
+    void resize_for_overwrite(std::size_t n) requires staticvec::detail::overwritable<T>
+    {
+        if (n > capacity()) [[unlikely]] {
+            n = staticvec::detail::overflow(capacity(),
+                                            "resize_for_overwrite past FixedVector size");
+        }
+
+        _header->size = n;
+    }
+
+    void clear()
+    {
+        std::destroy(begin(), end());
+        _header->size = 0;
+    }
+
+    iterator insert(const_iterator pos, const T& val)
+    {
+        return emplace(pos, val);
+    }
+
+    iterator insert(const_iterator pos, T&& val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    iterator insert(const_iterator pos, std::size_t count, const T& value)
+    {
+        std::size_t index = pos - data();
+
+        count = room_for(count, "insert past FixedVector size");
+        shift_back(index, count);
+        std::uninitialized_fill_n(data() + index, count, value);
+        _header->size += count;
+
+        return data() + index;
+    }
+
+    template<std::input_iterator IT>
+    iterator insert(const_iterator pos, IT first, IT last)
+    {
+        return insert_range(pos, std::ranges::subrange(first, last));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> l)
+    {
+        return insert(pos, l.begin(), l.end());
+    }
+
+    template<staticvec::detail::container_compatible_range<T> R>
+    iterator insert_range(const_iterator pos, R&& rg)
+    {
+        std::size_t index = pos - data();
+
+        if constexpr (std::ranges::forward_range<R> ||
+                      std::ranges::sized_range<R>) {
+            std::size_t count = room_for(std::ranges::distance(rg),
+                                         "insert past FixedVector size");
+
+            shift_back(index, count);
+            std::uninitialized_copy_n(std::ranges::begin(rg), count,
+                                      data() + index);
+            _header->size += count;
+        } else {
+            // Single pass ranges are appended and rotated into place
+            std::size_t old_size = size();
+
+            for (auto &&val : rg) {
+                if (0 == room_for(1, "insert past FixedVector size")) {
+                    break;
+                }
+
+                std::construct_at(end(), std::forward<decltype(val)>(val));
+                _header->size++;
+            }
+
+            std::rotate(data() + index, data() + old_size, end());
+        }
+
+        return data() + index;
+    }
+
+    template<staticvec::detail::container_compatible_range<T> R>
+    void append_range(R&& rg)
+    {
+        insert_range(cend(), std::forward<R>(rg));
+    }
+
+    template<typename ...Args>
+    iterator emplace(const_iterator pos, Args&& ...args)
+    {
+        std::size_t index = pos - data();
+
+        if (0 == room_for(1, "insert past FixedVector size")) {
+            return end();
+        }
+
+        if (index == size()) {
+            std::construct_at(end(), std::forward<Args>(args)...);
+        } else {
+            // The arguments may refer to elements about to be shifted
+            T tmp(std::forward<Args>(args)...);
+
+            shift_back(index);
+            std::construct_at(data() + index, std::move(tmp));
+        }
+        _header->size++;
+
+        return data() + index;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        if (pos == cend()) {
+            return end();
+        }
+
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        std::size_t index = first - data();
+        std::size_t stop = std::min<std::size_t>(last - data(), size());
+
+        if (index >= stop) {
+            return end();
+        }
+
+        std::destroy(data() + index, data() + stop);
+        staticvec::detail::relocate(data() + index, data() + stop,
+                                    size() - stop);
+        _header->size -= stop - index;
+
+        return data() + index;
+    }
+
+    T& push_back(const T &t)
+    {
+        return emplace_back(t);
+    }
+
+    T& push_back(T &&t)
+    {
+        return emplace_back(std::move(t));
+    }
+
+    // With the SATURATE policy a full vector drops the new element and
+    // returns the last one, which is left unchanged
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args)
+    {
+        if (0 == room_for(1, "push_back past FixedVector size")) {
+            if (empty()) {
+                // Nothing to refer to
+                std::abort();
+            }
+
+            return data()[size() - 1];
+        }
+
+        T *res = std::construct_at(end(), std::forward<Args>(args)...);
+        _header->size++;
+        return *res;
+    }
+
+    void pop_back()
+    {
+        if (empty()) {
+            return;
+        }
+
+        std::destroy_at(end() - 1);
+        _header->size--;
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + size();
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const
+    {
+        return data();
+    }
+
+    const_iterator cend() const
+    {
+        return data() + size();
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const
+    {
+        return rend();
+    }
+
+    iterator find(const T& val)
+    {
+        return std::find(begin(), end(), val);
+    }
+
+    const_iterator find(const T& val) const
+    {
+        return std::find(begin(), end(), val);
+    }
+
+    // Exchange the elements, not the buffers. Both vectors must have room for
+    // the other's elements; with the SATURATE policy nothing is exchanged
+    // otherwise.
+    void swap(FixedVector<T> &other)
+    {
+        if (_header == other._header) {
+            return;
+        }
+
+        if (other.size() > capacity() || size() > other.capacity()) [[unlikely]] {
+            staticvec::detail::overflow(0, "swap past FixedVector size");
+            return;
+        }
+
+        FixedVector<T> &longer = size() >= other.size() ? *this : other;
+        FixedVector<T> &shorter = size() >= other.size() ? other : *this;
+        std::size_t common = shorter.size();
+
+        std::swap_ranges(data(), data() + common, other.data());
+        staticvec::detail::relocate(shorter.data() + common,
+                                    longer.data() + common,
+                                    longer.size() - common);
+        std::swap(_header->size, other._header->size);
+    }
+
+    // Move the elements from at onwards into a new StaticVector, leaving this
+    // one with the elements before at
+    template<std::size_t R>
+    StaticVector<T, R> splitoff(const_iterator at)
+    {
+        StaticVector<T, R> res;
+        std::size_t index = at - data();
+        std::size_t count = size() - index;
+
+        if (count > R) [[unlikely]] {
+            count = staticvec::detail::overflow(R, "splitoff past StaticVector size");
+        }
+
+        res.append_range(std::ranges::subrange(
+            std::make_move_iterator(data() + index),
+            std::make_move_iterator(data() + index + count)));
+
+        std::destroy(data() + index, end());
+        _header->size = index;
+
+        return res;
+    }
+
+private:
+    staticvec::FixedVectorHeader *_header;
+
+    explicit FixedVector(staticvec::FixedVectorHeader *header)
+        : _header(header)
+    {
+
+    }
+
+    static void check_alignment(void *mem)
+    {
+        if (reinterpret_cast<std::uintptr_t>(mem) % alignment != 0) {
+            staticvec::detail::invalid_argument("FixedVector buffer misaligned");
+        }
+    }
+
+    std::size_t room_for(std::size_t count, const char *what) const
+    {
+        std::size_t room = capacity() - size();
+
+        if (count <= room) [[likely]] {
+            return count;
+        }
+
+        return staticvec::detail::overflow(room, what);
+    }
+
+    void shift_back(std::size_t at, std::size_t amnt = 1)
+    {
+        if (at >= size()) {
+            return;
+        }
+
+        staticvec::detail::relocate(data() + at + amnt, data() + at,
+                                    size() - at);
+    }
+};
+
+template<typename T>
+void swap(FixedVector<T> &a, FixedVector<T> &b)
+{
+    a.swap(b);
+}
+
+template<typename T>
+bool operator ==(const FixedVector<T> &a, const FixedVector<T> &b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// std::pmr::memory_resource handing out memory from a Bytes sized buffer
+// inside the object, so pmr containers can live on the stack or inside
+// another object without touching the heap. Allocation bumps a pointer.
+// Deallocation only gives memory back when it is the most recent allocation;
+// otherwise it is reclaimed by rewind() or release().
+//
+// Requests that do not fit go to the upstream resource, which by default
+// throws std::bad_alloc.
+template<std::size_t Bytes>
+class StaticArena : public std::pmr::memory_resource {
+public:
+    // Allocation state to return to with rewind()
+    class Marker {
+    private:
+        friend StaticArena<Bytes>;
+
+        explicit Marker(std::size_t used)
+            : _used(used)
+        {
+
+        }
+
+        std::size_t _used;
+    };
+
+    explicit StaticArena(std::pmr::memory_resource *upstream =
+                         std::pmr::null_memory_resource())
+        : _used(0), _upstream(upstream)
+    {
+
+    }
+
+    StaticArena(const StaticArena<Bytes> &) = delete;
+    StaticArena<Bytes>& operator=(const StaticArena<Bytes> &) = delete;
+
+    static constexpr std::size_t capacity()
+    {
+        return Bytes;
+    }
+
+    std::size_t used() const
+    {
+        return _used;
+    }
+
+    std::size_t remaining() const
+    {
+        return Bytes - _used;
+    }
+
+    std::pmr::memory_resource* upstream() const
+    {
+        return _upstream;
+    }
+
+    Marker mark() const
+    {
+        return Marker(_used);
+    }
+
+    // Free everything allocated from the buffer since m was taken. Objects
+    // in that memory must already be destroyed.
+    void rewind(Marker m)
+    {
+        if (m._used < _used) {
+            _used = m._used;
+        }
+    }
+
+    void release()
+    {
+        _used = 0;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_underling);
+        std::uintptr_t start = (base + _used + alignment - 1) & ~(alignment - 1);
+        std::size_t offset = start - base;
+
+        if (offset > Bytes || bytes > Bytes - offset) [[unlikely]] {
+            return _upstream->allocate(bytes, alignment);
+        }
+
+        _used = offset + bytes;
+        return _underling + offset;
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+    {
+        auto *ptr = static_cast<std::uint8_t *>(p);
+
+        if (ptr < _underling || ptr >= _underling + Bytes) [[unlikely]] {
+            _upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+
+        // Undo the last allocation, e.g. a vector growing in place
+        if (ptr + bytes == _underling + _used) {
+            _used = ptr - _underling;
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    alignas(std::max_align_t) std::uint8_t _underling[Bytes];
+    std::size_t _used;
+    std::pmr::memory_resource *_upstream;
+};
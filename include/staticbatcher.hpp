@@ -0,0 +1,273 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <staticvector.hpp>
+
+namespace staticvec {
+
+namespace detail {
+
+// Lockable that does nothing, for single threaded variants
+struct null_mutex {
+    void lock()
+    {
+
+    }
+
+    void unlock()
+    {
+
+    }
+};
+
+} // namespace detail
+
+template<typename Clock>
+struct BatcherStats {
+    std::uint64_t batches = 0;
+    std::uint64_t items = 0;
+    std::uint64_t full_flushes = 0;
+    std::uint64_t deadline_flushes = 0;
+    std::size_t max_batch = 0;
+
+    // Time from the first item of a batch until it was handed to the sink
+    typename Clock::duration total_latency{0};
+    typename Clock::duration max_latency{0};
+};
+
+} // namespace staticvec
+
+// Collects items into batches of up to S and hands each batch to
+// sink(std::span<T>) when it is full, when its first item is older than the
+// configured delay, or on flush(). The deadline is checked on every push and
+// by poll(), which an event loop should call by deadline().
+//
+// There are two buffers: while the sink processes one batch, producers fill
+// the other. With Concurrent, any thread may push and flush. Producers then
+// only block when the next batch fills up before the sink has finished the
+// previous one. The sink may consume the span's elements but must not keep
+// the span after it returns.
+template<typename T, std::size_t S, typename Sink,
+         bool Concurrent = false,
+         typename Clock = std::chrono::steady_clock>
+class StaticBatcher {
+    using mutex_type = std::conditional_t<Concurrent, std::mutex,
+                                          staticvec::detail::null_mutex>;
+
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+    using stats_type = staticvec::BatcherStats<Clock>;
+
+    explicit StaticBatcher(Sink sink, duration max_delay = duration::max())
+        : _sink(std::move(sink)), _max_delay(max_delay), _filling(0),
+          _generation(0), _deadline(time_point::max())
+    {
+
+    }
+
+    StaticBatcher(const StaticBatcher<T, S, Sink, Concurrent, Clock> &) = delete;
+    StaticBatcher<T, S, Sink, Concurrent, Clock>& operator=(
+        const StaticBatcher<T, S, Sink, Concurrent, Clock> &) = delete;
+
+    // Pending items are flushed. An exception from the sink cannot leave
+    // the destructor, so it is dropped along with the batch.
+    ~StaticBatcher()
+    {
+#ifdef __cpp_exceptions
+        try {
+            flush();
+        } catch (...) {
+        }
+#else
+        flush();
+#endif
+    }
+
+    void push(const T &val)
+    {
+        emplace(val);
+    }
+
+    void push(T &&val)
+    {
+        emplace(std::move(val));
+    }
+
+    template<typename ...Args>
+    void emplace(Args&& ...args)
+    {
+        for (;;) {
+            bool full = false;
+            bool late = false;
+            std::uint64_t generation;
+
+            {
+                std::lock_guard<mutex_type> lock(_lock);
+                StaticVector<T, S> &batch = _buffers[_filling];
+
+                generation = _generation;
+
+                if (batch.size() < S) {
+                    if (batch.empty()) {
+                        _first = now();
+                        _deadline = _max_delay == duration::max() ?
+                            time_point::max() : _first + _max_delay;
+                    }
+
+                    batch.emplace_back(std::forward<Args>(args)...);
+                    full = batch.size() == S;
+                    late = !full && _deadline != time_point::max() && now() >= _deadline;
+
+                    if (!full && !late) {
+                        return;
+                    }
+                }
+            }
+
+            if (full || late) {
+                dispatch(full ? &stats_type::full_flushes : &stats_type::deadline_flushes,
+                         generation);
+                return;
+            }
+
+            // Another producer filled the batch and is flushing it: wait for
+            // the sink to take it, then retry
+            std::lock_guard<mutex_type> wait(_sink_lock);
+        }
+    }
+
+    // Flush the pending batch if its deadline has passed. Returns whether it
+    // did.
+    bool poll()
+    {
+        std::uint64_t generation;
+
+        {
+            std::lock_guard<mutex_type> lock(_lock);
+
+            if (_buffers[_filling].empty() || now() < _deadline) {
+                return false;
+            }
+
+            generation = _generation;
+        }
+
+        dispatch(&stats_type::deadline_flushes, generation);
+        return true;
+    }
+
+    void flush()
+    {
+        dispatch(nullptr);
+    }
+
+    // When the pending batch must be flushed, if there is one and a delay
+    // was configured
+    std::optional<time_point> deadline() const
+    {
+        std::lock_guard<mutex_type> lock(_lock);
+
+        if (_buffers[_filling].empty() || _deadline == time_point::max()) {
+            return std::nullopt;
+        }
+
+        return _deadline;
+    }
+
+    // Number of items waiting for the next flush
+    std::size_t pending() const
+    {
+        std::lock_guard<mutex_type> lock(_lock);
+
+        return _buffers[_filling].size();
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return S;
+    }
+
+    stats_type stats() const
+    {
+        std::lock_guard<mutex_type> lock(_lock);
+
+        return _stats;
+    }
+
+private:
+    Sink _sink;
+    duration _max_delay;
+
+    // Protects the filling buffer, the deadline and the statistics
+    mutable mutex_type _lock;
+    // Held while the sink runs; the other buffer is free once it is released
+    mutex_type _sink_lock;
+
+    StaticVector<T, S> _buffers[2];
+    std::size_t _filling;
+    std::uint64_t _generation;
+    time_point _first;
+    time_point _deadline;
+    stats_type _stats;
+
+    static time_point now()
+    {
+        return Clock::now();
+    }
+
+    // Retire the filling batch and run the sink on it, counting the flush
+    // in reason unless it was explicit. With a generation, only that batch is
+    // flushed; another producer may already have done so.
+    void dispatch(std::uint64_t stats_type::*reason,
+                  std::uint64_t generation = UINT64_MAX)
+    {
+        std::lock_guard<mutex_type> sink_lock(_sink_lock);
+        StaticVector<T, S> *batch;
+
+        {
+            std::lock_guard<mutex_type> lock(_lock);
+
+            batch = &_buffers[_filling];
+            if (batch->empty() ||
+                (generation != UINT64_MAX && generation != _generation)) {
+                return;
+            }
+
+            duration latency = now() - _first;
+
+            _stats.batches++;
+            _stats.items += batch->size();
+            _stats.max_batch = std::max(_stats.max_batch, batch->size());
+            _stats.total_latency += latency;
+            _stats.max_latency = std::max(_stats.max_latency, latency);
+            if (reason) {
+                _stats.*reason += 1;
+            }
+
+            _filling ^= 1;
+            _generation++;
+            _deadline = time_point::max();
+        }
+
+        // The batch is emptied even if the sink throws
+        struct clear_on_exit {
+            StaticVector<T, S> *batch;
+
+            ~clear_on_exit()
+            {
+                batch->clear();
+            }
+        } guard{batch};
+
+        _sink(std::span<T>(batch->data(), batch->size()));
+    }
+};
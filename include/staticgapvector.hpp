@@ -0,0 +1,459 @@
+#pragma once
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <staticvector.hpp>
+
+// Fixed capacity sequence with a movable gap in its in-place storage, as used
+// by text editors. Elements before the cursor sit at the front of the
+// storage and the rest at the back. Inserting or erasing at the cursor is
+// O(1); an edit elsewhere first moves the cursor there, costing one
+// relocation per element passed. linearize() moves the gap to the end so the
+// elements are contiguous.
+template<typename T, std::size_t S>
+class StaticGapVector {
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+
+    template<typename U>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::remove_const_t<U>;
+        using pointer           = U*;
+        using reference         = U&;
+
+        basic_iterator()
+            : _parent(nullptr), _index(0)
+        {
+
+        }
+
+        template<typename V>
+            requires std::is_same_v<U, const V>
+        basic_iterator(const basic_iterator<V> &other)
+            : _parent(other._parent), _index(other._index)
+        {
+
+        }
+
+        reference operator*() const
+        {
+            return (*_parent)[_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*_parent)[_index];
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return (*_parent)[_index + n];
+        }
+
+        basic_iterator& operator++()
+        {
+            _index++;
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator tmp = *this;
+
+            _index++;
+            return tmp;
+        }
+
+        basic_iterator& operator--()
+        {
+            _index--;
+            return *this;
+        }
+
+        basic_iterator operator--(int)
+        {
+            basic_iterator tmp = *this;
+
+            _index--;
+            return tmp;
+        }
+
+        basic_iterator& operator+=(difference_type n)
+        {
+            _index += n;
+            return *this;
+        }
+
+        basic_iterator& operator-=(difference_type n)
+        {
+            _index -= n;
+            return *this;
+        }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend basic_iterator operator+(difference_type n, basic_iterator it)
+        {
+            return it += n;
+        }
+
+        friend basic_iterator operator-(basic_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const basic_iterator &a,
+                                         const basic_iterator &b)
+        {
+            return static_cast<difference_type>(a._index) -
+                static_cast<difference_type>(b._index);
+        }
+
+        friend bool operator ==(const basic_iterator &a, const basic_iterator &b)
+        {
+            return a._index == b._index;
+        }
+
+        friend auto operator <=>(const basic_iterator &a, const basic_iterator &b)
+        {
+            return a._index <=> b._index;
+        }
+
+    private:
+        friend StaticGapVector<T, S>;
+
+        template<typename>
+        friend class basic_iterator;
+
+        using parent_type = std::conditional_t<std::is_const_v<U>,
+              const StaticGapVector<T, S>, StaticGapVector<T, S>>;
+
+        basic_iterator(parent_type *parent, std::size_t index)
+            : _parent(parent), _index(index)
+        {
+
+        }
+
+        parent_type *_parent;
+        std::size_t _index;
+    };
+
+    using iterator       = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+
+    StaticGapVector()
+        : _gap_begin(0), _gap_end(S)
+    {
+
+    }
+
+    StaticGapVector(std::initializer_list<T> l)
+        : StaticGapVector()
+    {
+        insert_range(0, l);
+    }
+
+    StaticGapVector(const StaticGapVector<T, S> &other)
+        : _gap_begin(other._gap_begin), _gap_end(other._gap_end)
+    {
+        std::uninitialized_copy_n(other.slots(), _gap_begin, slots());
+        std::uninitialized_copy(other.slots() + _gap_end, other.slots() + S,
+                                slots() + _gap_end);
+    }
+
+    StaticGapVector(StaticGapVector<T, S> &&other)
+        : _gap_begin(other._gap_begin), _gap_end(other._gap_end)
+    {
+        staticvec::detail::relocate(slots(), other.slots(), _gap_begin);
+        staticvec::detail::relocate(slots() + _gap_end, other.slots() + _gap_end,
+                                    S - _gap_end);
+        other._gap_begin = 0;
+        other._gap_end = S;
+    }
+
+    StaticGapVector<T, S>& operator=(const StaticGapVector<T, S> &rhs)
+    {
+        if (this != &rhs) {
+            clear();
+            std::uninitialized_copy_n(rhs.slots(), rhs._gap_begin, slots());
+            std::uninitialized_copy(rhs.slots() + rhs._gap_end, rhs.slots() + S,
+                                    slots() + rhs._gap_end);
+            _gap_begin = rhs._gap_begin;
+            _gap_end = rhs._gap_end;
+        }
+
+        return *this;
+    }
+
+    StaticGapVector<T, S>& operator=(StaticGapVector<T, S> &&rhs)
+    {
+        if (this != &rhs) {
+            clear();
+            staticvec::detail::relocate(slots(), rhs.slots(), rhs._gap_begin);
+            staticvec::detail::relocate(slots() + rhs._gap_end,
+                                        rhs.slots() + rhs._gap_end,
+                                        S - rhs._gap_end);
+            _gap_begin = std::exchange(rhs._gap_begin, 0);
+            _gap_end = std::exchange(rhs._gap_end, S);
+        }
+
+        return *this;
+    }
+
+    ~StaticGapVector()
+    {
+        clear();
+    }
+
+    std::size_t size() const
+    {
+        return S - (_gap_end - _gap_begin);
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return S;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // Position of the gap, where edits are O(1)
+    std::size_t cursor() const
+    {
+        return _gap_begin;
+    }
+
+    void clear()
+    {
+        std::destroy(slots(), slots() + _gap_begin);
+        std::destroy(slots() + _gap_end, slots() + S);
+        _gap_begin = 0;
+        _gap_end = S;
+    }
+
+    T& operator[](std::size_t i)
+    {
+        if constexpr (staticvec::detail::check_enabled(STATICVEC_INDEX_CHECK)) {
+            if (i >= size()) [[unlikely]] {
+                staticvec::detail::out_of_range("StaticGapVector::operator[]");
+            }
+        }
+
+        return slots()[i < _gap_begin ? i : i + (_gap_end - _gap_begin)];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return const_cast<StaticGapVector<T, S> *>(this)->operator[](i);
+    }
+
+    T& at(std::size_t i)
+    {
+        if (i >= size()) [[unlikely]] {
+            staticvec::detail::out_of_range("StaticGapVector::at");
+        }
+
+        return (*this)[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        return const_cast<StaticGapVector<T, S> *>(this)->at(i);
+    }
+
+    T& front()
+    {
+        return at(0);
+    }
+
+    const T& front() const
+    {
+        return at(0);
+    }
+
+    T& back()
+    {
+        return at(size() - 1);
+    }
+
+    const T& back() const
+    {
+        return at(size() - 1);
+    }
+
+    // Move the gap to pos, relocating the elements in between
+    void move_cursor(std::size_t pos)
+    {
+        if (pos > size()) [[unlikely]] {
+            staticvec::detail::out_of_range("StaticGapVector::move_cursor");
+        }
+
+        if (pos < _gap_begin) {
+            std::size_t n = _gap_begin - pos;
+
+            staticvec::detail::relocate(slots() + _gap_end - n, slots() + pos, n);
+            _gap_begin -= n;
+            _gap_end -= n;
+        } else if (pos > _gap_begin) {
+            std::size_t n = pos - _gap_begin;
+
+            staticvec::detail::relocate(slots() + _gap_begin, slots() + _gap_end, n);
+            _gap_begin += n;
+            _gap_end += n;
+        }
+    }
+
+    // Close the gap and return the elements as one contiguous span
+    std::span<T> linearize()
+    {
+        move_cursor(size());
+        return std::span<T>(slots(), _gap_begin);
+    }
+
+    template<typename ...Args>
+    T& emplace(std::size_t pos, Args&& ...args)
+    {
+        if (_gap_begin == _gap_end) [[unlikely]] {
+            staticvec::detail::overflow(0, "insert past StaticGapVector size");
+
+            // Saturated: the new element was dropped
+            return (*this)[std::min(pos, size() - 1)];
+        }
+
+        if (pos == _gap_begin) {
+            return *std::construct_at(slots() + _gap_begin++, std::forward<Args>(args)...);
+        }
+
+        // The arguments may refer to elements about to be relocated
+        T tmp(std::forward<Args>(args)...);
+
+        move_cursor(pos);
+        return *std::construct_at(slots() + _gap_begin++, std::move(tmp));
+    }
+
+    T& insert(std::size_t pos, const T &val)
+    {
+        return emplace(pos, val);
+    }
+
+    T& insert(std::size_t pos, T &&val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    // Insert the elements of rg at pos, leaving the cursor after them
+    template<staticvec::detail::container_compatible_range<T> R>
+    void insert_range(std::size_t pos, R&& rg)
+    {
+        move_cursor(pos);
+
+        for (auto &&val : rg) {
+            if (_gap_begin == _gap_end) [[unlikely]] {
+                staticvec::detail::overflow(0, "insert past StaticGapVector size");
+                return;
+            }
+
+            std::construct_at(slots() + _gap_begin++,
+                              std::forward<decltype(val)>(val));
+        }
+    }
+
+    void push_back(const T &val)
+    {
+        emplace(size(), val);
+    }
+
+    void push_back(T &&val)
+    {
+        emplace(size(), std::move(val));
+    }
+
+    void pop_back()
+    {
+        if (!empty()) {
+            erase(size() - 1);
+        }
+    }
+
+    // Erase up to count elements starting at pos, leaving the cursor at pos
+    void erase(std::size_t pos, std::size_t count = 1)
+    {
+        move_cursor(pos);
+
+        count = std::min(count, S - _gap_end);
+        std::destroy(slots() + _gap_end, slots() + _gap_end + count);
+        _gap_end += count;
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+private:
+    alignas(T) uint8_t _underling[sizeof(T) * S];
+    std::size_t _gap_begin;
+    std::size_t _gap_end;
+
+    T* slots()
+    {
+        return reinterpret_cast<T *>(_underling);
+    }
+
+    const T* slots() const
+    {
+        return reinterpret_cast<const T *>(_underling);
+    }
+};
+
+template<typename T, std::size_t S>
+bool operator ==(const StaticGapVector<T, S> &a, const StaticGapVector<T, S> &b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
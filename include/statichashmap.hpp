@@ -0,0 +1,780 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <staticvector.hpp>
+
+namespace staticvec::detail {
+
+// Control byte of an empty slot, a tombstone, and otherwise the low 7 bits
+// of the hash of the key in the slot
+inline constexpr std::int8_t ctrl_empty = -128;
+inline constexpr std::int8_t ctrl_deleted = -2;
+
+inline constexpr std::size_t group_width = 16;
+
+// Bit i is set when control byte i of a group matches
+struct group {
+#ifdef __SSE2__
+    __m128i ctrl;
+
+    explicit group(const std::int8_t *p)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))
+    {
+
+    }
+
+    unsigned match(std::int8_t h2) const
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+    }
+
+    // Full slots have the sign bit clear
+    unsigned match_free() const
+    {
+        return _mm_movemask_epi8(ctrl);
+    }
+#else
+    const std::int8_t *ctrl;
+
+    explicit group(const std::int8_t *p)
+        : ctrl(p)
+    {
+
+    }
+
+    unsigned match(std::int8_t h2) const
+    {
+        unsigned mask = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= unsigned(ctrl[i] == h2) << i;
+        }
+
+        return mask;
+    }
+
+    unsigned match_free() const
+    {
+        unsigned mask = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= unsigned(ctrl[i] < 0) << i;
+        }
+
+        return mask;
+    }
+#endif
+
+    unsigned match_empty() const
+    {
+        return match(ctrl_empty);
+    }
+};
+
+template<typename Hash, typename Eq>
+concept transparent_lookup =
+    requires { typename Hash::is_transparent; typename Eq::is_transparent; };
+
+// Other key types are converted once per lookup unless both Hash and Eq are
+// transparent
+template<typename Hash, typename Eq, typename Q, typename K>
+concept hash_lookup = transparent_lookup<Hash, Eq> || std::is_constructible_v<K, const Q &>;
+
+struct set_key {
+    template<typename T>
+    const T& operator()(const T &val) const
+    {
+        return val;
+    }
+};
+
+struct map_key {
+    template<typename P>
+    const auto& operator()(const P &val) const
+    {
+        return val.first;
+    }
+};
+
+// Open addressing table of at most S elements in groups of 16 slots, with
+// one control byte per slot (Swiss table). Lookups compare the 7 bit hash
+// fragments of a whole group at once and stop at the first group with an
+// empty slot. Erasing leaves a tombstone only when that group is full, and
+// tombstones are cleared by rehashing in place once they use up the spare
+// slots, so the table never allocates.
+template<typename Key, typename Value, std::size_t S, typename Hash,
+         typename Eq, typename KeyOf>
+class swiss_table {
+public:
+    // Slots for S elements at a load factor of at most 7/8
+    static constexpr std::size_t slot_count =
+        std::bit_ceil(std::max<std::size_t>(group_width, (S * 8 + 6) / 7));
+    static constexpr std::size_t group_count = slot_count / group_width;
+    static constexpr std::size_t max_load = slot_count - slot_count / 8;
+
+    template<typename U>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::remove_const_t<U>;
+        using pointer           = U*;
+        using reference         = U&;
+
+        basic_iterator()
+            : _table(nullptr), _slot(0)
+        {
+
+        }
+
+        template<typename V>
+            requires std::is_same_v<U, const V>
+        basic_iterator(const basic_iterator<V> &other)
+            : _table(other._table), _slot(other._slot)
+        {
+
+        }
+
+        reference operator*() const
+        {
+            return _table->slots()[_slot];
+        }
+
+        pointer operator->() const
+        {
+            return &_table->slots()[_slot];
+        }
+
+        basic_iterator& operator++()
+        {
+            _slot = _table->next_full(_slot + 1);
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator tmp = *this;
+
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator ==(const basic_iterator &a, const basic_iterator &b)
+        {
+            return a._slot == b._slot;
+        }
+
+    private:
+        friend swiss_table;
+
+        template<typename>
+        friend class basic_iterator;
+
+        using table_type = std::conditional_t<std::is_const_v<U>,
+              const swiss_table, swiss_table>;
+
+        basic_iterator(table_type *table, std::size_t slot)
+            : _table(table), _slot(slot)
+        {
+
+        }
+
+        table_type *_table;
+        std::size_t _slot;
+    };
+
+    using iterator       = basic_iterator<Value>;
+    using const_iterator = basic_iterator<const Value>;
+
+    swiss_table(const Hash &hash = Hash(), const Eq &eq = Eq())
+        : _hash(hash), _eq(eq)
+    {
+        reset_ctrl();
+    }
+
+    swiss_table(const swiss_table &other)
+        : _hash(other._hash), _eq(other._eq)
+    {
+        copy_from(other);
+    }
+
+    // Elements are moved slot by slot; the source is left empty
+    swiss_table(swiss_table &&other)
+        : _hash(other._hash), _eq(other._eq)
+    {
+        move_from(other);
+    }
+
+    swiss_table& operator=(const swiss_table &rhs)
+    {
+        if (this != &rhs) {
+            clear();
+            _hash = rhs._hash;
+            _eq = rhs._eq;
+            copy_from(rhs);
+        }
+
+        return *this;
+    }
+
+    swiss_table& operator=(swiss_table &&rhs)
+    {
+        if (this != &rhs) {
+            clear();
+            _hash = rhs._hash;
+            _eq = rhs._eq;
+            move_from(rhs);
+        }
+
+        return *this;
+    }
+
+    ~swiss_table()
+    {
+        clear();
+    }
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return S;
+    }
+
+    void clear()
+    {
+        if constexpr (!std::is_trivially_destructible_v<Value>) {
+            for (std::size_t i = 0; i < slot_count; ++i) {
+                if (_ctrl[i] >= 0) {
+                    std::destroy_at(slots() + i);
+                }
+            }
+        }
+
+        reset_ctrl();
+    }
+
+    iterator begin()
+    {
+        return iterator(this, next_full(0));
+    }
+
+    iterator end()
+    {
+        return iterator(this, slot_count);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, next_full(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, slot_count);
+    }
+
+    template<typename Q>
+        requires hash_lookup<Hash, Eq, Q, Key>
+    iterator find(const Q &key)
+    {
+        const auto &k = lookup_key(key);
+
+        return iterator(this, find_slot(k, hash_of(k)));
+    }
+
+    template<typename Q>
+        requires hash_lookup<Hash, Eq, Q, Key>
+    const_iterator find(const Q &key) const
+    {
+        const auto &k = lookup_key(key);
+
+        return const_iterator(this, find_slot(k, hash_of(k)));
+    }
+
+    template<typename Q>
+        requires hash_lookup<Hash, Eq, Q, Key>
+    bool contains(const Q &key) const
+    {
+        const auto &k = lookup_key(key);
+
+        return find_slot(k, hash_of(k)) != slot_count;
+    }
+
+    template<typename Q>
+        requires hash_lookup<Hash, Eq, Q, Key>
+    std::size_t count(const Q &key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename Q>
+        requires hash_lookup<Hash, Eq, Q, Key>
+    std::size_t erase(const Q &key)
+    {
+        const auto &k = lookup_key(key);
+        std::size_t slot = find_slot(k, hash_of(k));
+
+        if (slot == slot_count) {
+            return 0;
+        }
+
+        erase_slot(slot);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        erase_slot(pos._slot);
+        return iterator(this, next_full(pos._slot + 1));
+    }
+
+protected:
+    // Find key, or construct a value from args in a free slot. Returns the
+    // slot and whether the value was constructed; the slot is slot_count if
+    // the table is full and the overflow policy saturates.
+    template<typename Q, typename ...Args>
+    std::pair<std::size_t, bool> find_or_emplace(const Q &key, Args&& ...args)
+    {
+        std::uint64_t h = hash_of(key);
+        std::size_t slot = find_slot(key, h);
+
+        if (slot != slot_count) {
+            return {slot, false};
+        }
+
+        if (_size == S) [[unlikely]] {
+            staticvec::detail::overflow(0, "insert past StaticHashMap size");
+            return {slot_count, false};
+        }
+
+        slot = free_slot(h);
+        if (_ctrl[slot] == ctrl_empty && _size + _tombstones == max_load) {
+            rehash_in_place();
+            slot = free_slot(h);
+        }
+
+        std::construct_at(slots() + slot, std::forward<Args>(args)...);
+        set_ctrl(slot, h);
+        return {slot, true};
+    }
+
+    iterator iterator_at(std::size_t slot)
+    {
+        return iterator(this, slot);
+    }
+
+    const_iterator iterator_at(std::size_t slot) const
+    {
+        return const_iterator(this, slot);
+    }
+
+    Value* slots()
+    {
+        return reinterpret_cast<Value *>(_slots);
+    }
+
+    const Value* slots() const
+    {
+        return reinterpret_cast<const Value *>(_slots);
+    }
+
+private:
+    alignas(Value) std::uint8_t _slots[sizeof(Value) * slot_count];
+    std::int8_t _ctrl[slot_count];
+    std::size_t _size;
+    std::size_t _tombstones;
+    [[no_unique_address]] Hash _hash;
+    [[no_unique_address]] Eq _eq;
+
+    template<typename Q>
+    decltype(auto) lookup_key(const Q &key) const
+    {
+        if constexpr (transparent_lookup<Hash, Eq> || std::is_same_v<Q, Key>) {
+            return (key);
+        } else {
+            return Key(key);
+        }
+    }
+
+    template<typename Q>
+    std::uint64_t hash_of(const Q &key) const
+    {
+        // Spread weak hashes such as the identity of std::hash<int>
+        return staticvec::detail::wymix(static_cast<std::uint64_t>(_hash(key)) ^
+                                        staticvec::detail::wysecret[0],
+                                        staticvec::detail::wysecret[1]);
+    }
+
+    static std::size_t first_group(std::uint64_t h)
+    {
+        return (h >> 7) & (group_count - 1);
+    }
+
+    static std::int8_t fragment(std::uint64_t h)
+    {
+        return static_cast<std::int8_t>(h & 0x7f);
+    }
+
+    // Groups are visited in triangular order, which covers every group of a
+    // power of two table
+    template<typename F>
+    static std::size_t probe(std::uint64_t h, F &&visit)
+    {
+        std::size_t g = first_group(h);
+
+        for (std::size_t i = 1; i <= group_count; ++i) {
+            std::size_t res = visit(g * group_width);
+            if (res != SIZE_MAX) {
+                return res;
+            }
+
+            g = (g + i) & (group_count - 1);
+        }
+
+        return slot_count;
+    }
+
+    template<typename Q>
+    std::size_t find_slot(const Q &key, std::uint64_t h) const
+    {
+        std::int8_t h2 = fragment(h);
+
+        return probe(h, [&](std::size_t base) {
+            group grp(_ctrl + base);
+
+            for (unsigned m = grp.match(h2); m != 0; m &= m - 1) {
+                std::size_t slot = base + std::countr_zero(m);
+
+                if (_eq(KeyOf()(slots()[slot]), key)) [[likely]] {
+                    return slot;
+                }
+            }
+
+            return grp.match_empty() != 0 ? slot_count : SIZE_MAX;
+        });
+    }
+
+    // First empty or deleted slot on the probe sequence of h. The load
+    // limit keeps a slot free, so unlike probe() this never runs out
+    std::size_t free_slot(std::uint64_t h) const
+    {
+        std::size_t g = first_group(h);
+
+        for (std::size_t i = 1;; ++i) {
+            unsigned m = group(_ctrl + g * group_width).match_free();
+
+            // The mask bounds the index for the compiler's benefit
+            if (m != 0) {
+                return g * group_width + std::countr_zero(m) % group_width;
+            }
+
+            g = (g + i) & (group_count - 1);
+        }
+    }
+
+    std::size_t next_full(std::size_t slot) const
+    {
+        while (slot < slot_count && _ctrl[slot] < 0) {
+            slot++;
+        }
+
+        return slot;
+    }
+
+    void set_ctrl(std::size_t slot, std::uint64_t h)
+    {
+        if (_ctrl[slot] == ctrl_deleted) {
+            _tombstones--;
+        }
+
+        _ctrl[slot] = fragment(h);
+        _size++;
+    }
+
+    // Same slots as other, so no rehashing is needed
+    void copy_from(const swiss_table &other)
+    {
+        std::copy_n(other._ctrl, slot_count, _ctrl);
+        _size = other._size;
+        _tombstones = other._tombstones;
+
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (_ctrl[i] >= 0) {
+                std::construct_at(slots() + i, other.slots()[i]);
+            }
+        }
+    }
+
+    void move_from(swiss_table &other)
+    {
+        std::copy_n(other._ctrl, slot_count, _ctrl);
+        _size = other._size;
+        _tombstones = other._tombstones;
+
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (_ctrl[i] >= 0) {
+                std::construct_at(slots() + i, std::move(other.slots()[i]));
+            }
+        }
+
+        other.clear();
+    }
+
+    void reset_ctrl()
+    {
+        std::fill_n(_ctrl, slot_count, ctrl_empty);
+        _size = 0;
+        _tombstones = 0;
+    }
+
+    void erase_slot(std::size_t slot)
+    {
+        std::size_t base = slot / group_width * group_width;
+
+        std::destroy_at(slots() + slot);
+        _size--;
+
+        // A group that still has an empty slot never made a probe move on,
+        // so no tombstone is needed
+        if (group(_ctrl + base).match_empty() != 0) {
+            _ctrl[slot] = ctrl_empty;
+        } else {
+            _ctrl[slot] = ctrl_deleted;
+            _tombstones++;
+        }
+    }
+
+    void move_slot(std::size_t dst, std::size_t src)
+    {
+        std::construct_at(slots() + dst, std::move(slots()[src]));
+        std::destroy_at(slots() + src);
+    }
+
+    // Drop all tombstones without extra storage: mark the live elements
+    // as deleted, then put each one where a fresh insert would go, swapping
+    // with any element still waiting to be placed
+    void rehash_in_place()
+    {
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            _ctrl[i] = _ctrl[i] >= 0 ? ctrl_deleted : ctrl_empty;
+        }
+
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (_ctrl[i] != ctrl_deleted) {
+                continue;
+            }
+
+            std::uint64_t h = hash_of(KeyOf()(slots()[i]));
+            std::size_t target = free_slot(h);
+
+            if (target / group_width == i / group_width) {
+                _ctrl[i] = fragment(h);
+            } else if (_ctrl[target] == ctrl_empty) {
+                move_slot(target, i);
+                _ctrl[target] = fragment(h);
+                _ctrl[i] = ctrl_empty;
+            } else {
+                // Swap with the unplaced element at target and place the
+                // element that arrives in slot i next
+                Value tmp(std::move(slots()[target]));
+
+                std::destroy_at(slots() + target);
+                move_slot(target, i);
+                std::construct_at(slots() + i, std::move(tmp));
+                _ctrl[target] = fragment(h);
+                i--;
+            }
+        }
+
+        _tombstones = 0;
+    }
+};
+
+} // namespace staticvec::detail
+
+// Fixed capacity hash map of at most S elements kept entirely in the object.
+// Lookups accept any key type when Hash and KeyEqual are transparent.
+template<typename K, typename V, std::size_t S,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>>
+class StaticHashMap
+    : public staticvec::detail::swiss_table<K, std::pair<const K, V>, S, Hash,
+                                            KeyEqual, staticvec::detail::map_key>
+{
+    using base_type = staticvec::detail::swiss_table<K, std::pair<const K, V>, S,
+          Hash, KeyEqual, staticvec::detail::map_key>;
+
+public:
+    using key_type    = K;
+    using mapped_type = V;
+    using value_type  = std::pair<const K, V>;
+    using iterator    = typename base_type::iterator;
+    using const_iterator = typename base_type::const_iterator;
+
+    StaticHashMap() = default;
+
+    explicit StaticHashMap(const Hash &hash, const KeyEqual &eq = KeyEqual())
+        : base_type(hash, eq)
+    {
+
+    }
+
+    StaticHashMap(std::initializer_list<value_type> l)
+    {
+        for (const value_type &val : l) {
+            insert(val);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const value_type &val)
+    {
+        return try_emplace(val.first, val.second);
+    }
+
+    // With the SATURATE policy a new key in a full map is dropped and the
+    // result is {end(), false}
+    template<typename ...Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args&& ...args)
+    {
+        auto [slot, inserted] = this->find_or_emplace(key, std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+
+        return {this->iterator_at(slot), inserted};
+    }
+
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const K &key, M &&val)
+    {
+        auto res = try_emplace(key, std::forward<M>(val));
+
+        if (!res.second && res.first != this->end()) {
+            res.first->second = std::forward<M>(val);
+        }
+
+        return res;
+    }
+
+    // A new key in a full map has no element to refer to, so with the
+    // SATURATE policy this aborts; try_emplace reports it through end()
+    V& operator[](const K &key)
+    {
+        std::size_t slot = this->find_or_emplace(key, std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple()).first;
+
+        if (slot == base_type::slot_count) [[unlikely]] {
+            std::abort();
+        }
+
+        return this->slots()[slot].second;
+    }
+
+    template<typename Q>
+        requires staticvec::detail::hash_lookup<Hash, KeyEqual, Q, K>
+    V& at(const Q &key)
+    {
+        auto it = this->find(key);
+
+        if (it == this->end()) [[unlikely]] {
+            staticvec::detail::out_of_range("StaticHashMap::at");
+        }
+
+        return it->second;
+    }
+
+    template<typename Q>
+        requires staticvec::detail::hash_lookup<Hash, KeyEqual, Q, K>
+    const V& at(const Q &key) const
+    {
+        return const_cast<StaticHashMap<K, V, S, Hash, KeyEqual> *>(this)->at(key);
+    }
+};
+
+// Fixed capacity hash set of at most S keys kept entirely in the object
+template<typename K, std::size_t S,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>>
+class StaticHashSet
+    : public staticvec::detail::swiss_table<K, K, S, Hash, KeyEqual,
+                                            staticvec::detail::set_key>
+{
+    using base_type = staticvec::detail::swiss_table<K, K, S, Hash, KeyEqual,
+          staticvec::detail::set_key>;
+
+public:
+    using key_type   = K;
+    using value_type = K;
+    using iterator   = typename base_type::const_iterator;
+    using const_iterator = typename base_type::const_iterator;
+
+    StaticHashSet() = default;
+
+    explicit StaticHashSet(const Hash &hash, const KeyEqual &eq = KeyEqual())
+        : base_type(hash, eq)
+    {
+
+    }
+
+    StaticHashSet(std::initializer_list<K> l)
+    {
+        for (const K &key : l) {
+            insert(key);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const K &key)
+    {
+        auto [slot, inserted] = this->find_or_emplace(key, key);
+
+        return {std::as_const(*this).iterator_at(slot), inserted};
+    }
+
+    // Keys are immutable, so only const iterators are handed out
+    template<typename Q>
+        requires staticvec::detail::hash_lookup<Hash, KeyEqual, Q, K>
+    const_iterator find(const Q &key) const
+    {
+        return base_type::find(key);
+    }
+
+    const_iterator begin() const
+    {
+        return base_type::begin();
+    }
+
+    const_iterator end() const
+    {
+        return base_type::end();
+    }
+
+    using base_type::erase;
+
+    const_iterator erase(const_iterator pos)
+    {
+        return base_type::erase(pos);
+    }
+};
@@ -0,0 +1,286 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <staticvector.hpp>
+
+namespace staticvec {
+
+// Default IndexMap for StaticHeap: positions are not tracked
+struct NoHeapIndex {
+    template<typename T>
+    void operator()(const T &, std::size_t) const
+    {
+
+    }
+};
+
+} // namespace staticvec
+
+// Fixed capacity D-ary heap stored in a StaticVector. Like
+// std::priority_queue, top() is the greatest element according to Compare.
+//
+// IndexMap is called as index(element, position) whenever an element is
+// placed at a new position. Recording those positions enables modify() and
+// erase() of arbitrary elements, e.g. decrease-key for timers.
+template<typename T, std::size_t S,
+         typename Compare = std::less<T>,
+         std::size_t D = 4,
+         typename IndexMap = staticvec::NoHeapIndex>
+class StaticHeap {
+    static_assert(D >= 2, "heap arity must be at least 2");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using const_iterator  = typename StaticVector<T, S>::const_iterator;
+
+    StaticHeap(const Compare &comp = Compare(), const IndexMap &index = IndexMap())
+        : _comp(comp), _index(index)
+    {
+
+    }
+
+    template<staticvec::detail::container_compatible_range<T> R>
+    StaticHeap(R&& rg, const Compare &comp = Compare(),
+               const IndexMap &index = IndexMap())
+        : StaticHeap(comp, index)
+    {
+        heapify(std::forward<R>(rg));
+    }
+
+    std::size_t size() const
+    {
+        return _data.size();
+    }
+
+    std::size_t capacity() const
+    {
+        return S;
+    }
+
+    bool empty() const
+    {
+        return _data.empty();
+    }
+
+    void clear()
+    {
+        _data.clear();
+    }
+
+    const T& top() const
+    {
+        return _data.front();
+    }
+
+    // Element at a heap position, as reported to the IndexMap
+    const T& operator[](std::size_t pos) const
+    {
+        return _data[pos];
+    }
+
+    // Elements in heap order
+    const_iterator begin() const
+    {
+        return _data.begin();
+    }
+
+    const_iterator end() const
+    {
+        return _data.end();
+    }
+
+    void push(const T &val)
+    {
+        emplace(val);
+    }
+
+    void push(T &&val)
+    {
+        emplace(std::move(val));
+    }
+
+    template<typename ...Args>
+    void emplace(Args&& ...args)
+    {
+        std::size_t pos = _data.size();
+
+        _data.emplace_back(std::forward<Args>(args)...);
+        if (_data.size() == pos) {
+            // Saturated: the element was dropped
+            return;
+        }
+
+        sift_up(pos, take(pos));
+    }
+
+    void pop()
+    {
+        if (empty()) {
+            return;
+        }
+
+        T last = std::move(_data.back());
+        _data.pop_back();
+
+        if (!empty()) {
+            sift_down(0, std::move(last));
+        }
+    }
+
+    // Replace the top element, cheaper than pop() followed by push()
+    void replace_top(const T &val)
+    {
+        T tmp(val);
+
+        replace_top(std::move(tmp));
+    }
+
+    void replace_top(T &&val)
+    {
+        if (empty()) {
+            push(std::move(val));
+            return;
+        }
+
+        sift_down(0, std::move(val));
+    }
+
+    // Replace the contents with the elements of rg in O(n)
+    template<staticvec::detail::container_compatible_range<T> R>
+    void heapify(R&& rg)
+    {
+        _data.assign_range(std::forward<R>(rg));
+
+        std::size_t n = _data.size();
+        if (n < 2) {
+            notify(0, n);
+            return;
+        }
+
+        for (std::size_t i = parent(n - 1) + 1; i > 0; --i) {
+            sift_down(i - 1, take(i - 1));
+        }
+
+        notify(parent(n - 1) + 1, n);
+    }
+
+    // Apply f to the element at pos and restore the heap order, e.g. after
+    // decreasing its key
+    template<typename F>
+    void modify(std::size_t pos, F &&f)
+    {
+        std::invoke(std::forward<F>(f), _data[pos]);
+        update(pos);
+    }
+
+    void erase(std::size_t pos)
+    {
+        T last = std::move(_data.back());
+        _data.pop_back();
+
+        if (pos < _data.size()) {
+            _data[pos] = std::move(last);
+            update(pos);
+        }
+    }
+
+private:
+    StaticVector<T, S> _data;
+    [[no_unique_address]] Compare _comp;
+    [[no_unique_address]] IndexMap _index;
+
+    static std::size_t parent(std::size_t i)
+    {
+        return (i - 1) / D;
+    }
+
+    static std::size_t first_child(std::size_t i)
+    {
+        return i * D + 1;
+    }
+
+    T take(std::size_t pos)
+    {
+        return std::move(_data[pos]);
+    }
+
+    void place(std::size_t pos, T &&val)
+    {
+        _data[pos] = std::move(val);
+        _index(_data[pos], pos);
+    }
+
+    void place_from(std::size_t dst, std::size_t src)
+    {
+        _data[dst] = std::move(_data[src]);
+        _index(_data[dst], dst);
+    }
+
+    void notify(std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i) {
+            _index(_data[i], i);
+        }
+    }
+
+    void update(std::size_t pos)
+    {
+        if (pos > 0 && _comp(_data[parent(pos)], _data[pos])) {
+            sift_up(pos, take(pos));
+        } else {
+            sift_down(pos, take(pos));
+        }
+    }
+
+    // Move val up from the hole at pos
+    void sift_up(std::size_t pos, T &&val)
+    {
+        while (pos > 0) {
+            std::size_t p = parent(pos);
+
+            if (!_comp(_data[p], val)) {
+                break;
+            }
+
+            place_from(pos, p);
+            pos = p;
+        }
+
+        place(pos, std::move(val));
+    }
+
+    // Move val down from the hole at pos
+    void sift_down(std::size_t pos, T &&val)
+    {
+        std::size_t n = _data.size();
+
+        for (;;) {
+            std::size_t child = first_child(pos);
+            if (child >= n) {
+                break;
+            }
+
+            std::size_t last = std::min(child + D, n);
+            std::size_t best = child;
+
+            for (++child; child < last; ++child) {
+                if (_comp(_data[best], _data[child])) {
+                    best = child;
+                }
+            }
+
+            if (!_comp(val, _data[best])) {
+                break;
+            }
+
+            place_from(pos, best);
+            pos = best;
+        }
+
+        place(pos, std::move(val));
+    }
+};
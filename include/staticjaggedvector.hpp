@@ -0,0 +1,341 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include <staticvector.hpp>
+
+// Up to MaxRows variable length rows holding at most TotalCap elements in
+// total, stored back to back (CSR layout) with an offsets array.
+template<typename T, std::size_t TotalCap, std::size_t MaxRows>
+class StaticJaggedVector {
+    using offset_type = staticvec::detail::offset_t<TotalCap>;
+
+public:
+    using value_type = T;
+    using row_type = std::span<T>;
+    using const_row_type = std::span<const T>;
+
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    // Random access in C++20 terms. Rows are returned by value, so for older
+    // algorithms it is only an input iterator.
+    template<typename U>
+    class row_iterator {
+    public:
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::span<U>;
+        using reference         = std::span<U>;
+
+        row_iterator()
+            : _parent(nullptr), _row(0)
+        {
+
+        }
+
+        reference operator*() const
+        {
+            return _parent->row(_row);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return _parent->row(_row + n);
+        }
+
+        row_iterator& operator++()
+        {
+            _row++;
+            return *this;
+        }
+
+        row_iterator operator++(int)
+        {
+            row_iterator tmp = *this;
+
+            _row++;
+            return tmp;
+        }
+
+        row_iterator& operator--()
+        {
+            _row--;
+            return *this;
+        }
+
+        row_iterator operator--(int)
+        {
+            row_iterator tmp = *this;
+
+            _row--;
+            return tmp;
+        }
+
+        row_iterator& operator+=(difference_type n)
+        {
+            _row += n;
+            return *this;
+        }
+
+        row_iterator& operator-=(difference_type n)
+        {
+            _row -= n;
+            return *this;
+        }
+
+        friend row_iterator operator+(row_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend row_iterator operator+(difference_type n, row_iterator it)
+        {
+            return it += n;
+        }
+
+        friend row_iterator operator-(row_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const row_iterator &a,
+                                         const row_iterator &b)
+        {
+            return static_cast<difference_type>(a._row) -
+                static_cast<difference_type>(b._row);
+        }
+
+        friend bool operator ==(const row_iterator &a, const row_iterator &b)
+        {
+            return a._row == b._row;
+        }
+
+        friend auto operator <=>(const row_iterator &a, const row_iterator &b)
+        {
+            return a._row <=> b._row;
+        }
+
+    private:
+        friend StaticJaggedVector<T, TotalCap, MaxRows>;
+
+        using parent_type = std::conditional_t<std::is_const_v<U>,
+              const StaticJaggedVector<T, TotalCap, MaxRows>,
+              StaticJaggedVector<T, TotalCap, MaxRows>>;
+
+        row_iterator(parent_type *parent, std::size_t row)
+            : _parent(parent), _row(row)
+        {
+
+        }
+
+        parent_type *_parent;
+        std::size_t _row;
+    };
+
+    using iterator = row_iterator<T>;
+    using const_iterator = row_iterator<const T>;
+
+    StaticJaggedVector()
+    {
+        _offsets.push_back(0);
+    }
+
+    // Number of rows
+    std::size_t size() const
+    {
+        return _offsets.size() - 1;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // Number of elements in all rows
+    std::size_t element_count() const
+    {
+        return _values.size();
+    }
+
+    static constexpr std::size_t max_rows()
+    {
+        return MaxRows;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return TotalCap;
+    }
+
+    void clear()
+    {
+        _values.clear();
+        _offsets.clear();
+        _offsets.push_back(0);
+    }
+
+    std::span<T> row(std::size_t i)
+    {
+        return std::span<T>(_values.data() + _offsets[i],
+                            _offsets[i + 1] - _offsets[i]);
+    }
+
+    std::span<const T> row(std::size_t i) const
+    {
+        return std::span<const T>(_values.data() + _offsets[i],
+                                  _offsets[i + 1] - _offsets[i]);
+    }
+
+    std::span<T> operator[](std::size_t i)
+    {
+        return row(i);
+    }
+
+    std::span<const T> operator[](std::size_t i) const
+    {
+        return row(i);
+    }
+
+    std::span<T> at(std::size_t i)
+    {
+        if (i >= size()) [[unlikely]] {
+            staticvec::detail::out_of_range("StaticJaggedVector::at");
+        }
+
+        return row(i);
+    }
+
+    std::span<const T> at(std::size_t i) const
+    {
+        return const_cast<StaticJaggedVector<T, TotalCap, MaxRows> *>(this)->at(i);
+    }
+
+    // All elements of all rows as one span
+    std::span<T> flat()
+    {
+        return std::span<T>(_values.data(), _values.size());
+    }
+
+    std::span<const T> flat() const
+    {
+        return std::span<const T>(_values.data(), _values.size());
+    }
+
+    // Append a row and return its index. If appending the elements throws,
+    // the row is removed again. With the SATURATE policy a row that does not
+    // fit in the row table is dropped and npos returned.
+    template<staticvec::detail::container_compatible_range<T> R>
+    std::size_t push_row(R&& rg)
+    {
+        struct rollback {
+            StaticJaggedVector<T, TotalCap, MaxRows> *self;
+            std::size_t rows;
+            std::size_t values;
+
+            ~rollback()
+            {
+                if (self) {
+                    self->_values.erase(self->_values.cbegin() + values,
+                                        self->_values.cend());
+                    self->_offsets.erase(self->_offsets.cbegin() + rows,
+                                         self->_offsets.cend());
+                    self->_offsets.back() = static_cast<offset_type>(values);
+                }
+            }
+        } guard{this, _offsets.size(), _values.size()};
+
+        std::size_t index = add_row();
+
+        if (index == npos) [[unlikely]] {
+            guard.self = nullptr;
+            return npos;
+        }
+
+        _values.append_range(std::forward<R>(rg));
+        _offsets.back() = static_cast<offset_type>(_values.size());
+        guard.self = nullptr;
+        return index;
+    }
+
+    std::size_t push_row(std::initializer_list<T> l)
+    {
+        return push_row(std::span<const T>(l.begin(), l.size()));
+    }
+
+    // Start a new empty row, to be filled with push_back. Returns its index,
+    // or npos when the row table is full and the policy saturates.
+    std::size_t add_row()
+    {
+        if (_offsets.size() > MaxRows) [[unlikely]] {
+            staticvec::detail::overflow(0, "push_row past StaticJaggedVector rows");
+            return npos;
+        }
+
+        _offsets.push_back(_offsets.back());
+        return size() - 1;
+    }
+
+    // Append an element to the last row, starting one if there is none
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args)
+    {
+        if (empty() && add_row() == npos) [[unlikely]] {
+            // No row to hold the element or to refer to
+            std::abort();
+        }
+
+        T &res = _values.emplace_back(std::forward<Args>(args)...);
+
+        _offsets.back() = static_cast<offset_type>(_values.size());
+        return res;
+    }
+
+    T& push_back(const T &val)
+    {
+        return emplace_back(val);
+    }
+
+    T& push_back(T &&val)
+    {
+        return emplace_back(std::move(val));
+    }
+
+    void pop_row()
+    {
+        if (empty()) {
+            return;
+        }
+
+        _offsets.pop_back();
+        _values.erase(_values.cbegin() + _offsets.back(), _values.cend());
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+private:
+    StaticVector<T, TotalCap> _values;
+    StaticVector<offset_type, MaxRows + 1> _offsets;
+};
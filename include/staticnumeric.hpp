@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+#include <staticvector.hpp>
+
+namespace staticvec::detail {
+
+template<typename T>
+concept numeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+#ifdef __cpp_lib_experimental_parallel_simd
+template<typename T>
+using simd_t = std::experimental::native_simd<T>;
+
+template<typename V, typename T>
+V load(const T *p)
+{
+    return V(p, std::experimental::element_aligned);
+}
+
+template<typename V, typename T>
+void store(const V &v, T *p)
+{
+    v.copy_to(p, std::experimental::element_aligned);
+}
+
+template<typename V, typename T, typename Op>
+T fold_lanes(const V &v, T res, Op op)
+{
+    for (std::size_t l = 0; l < V::size(); ++l) {
+        res = op(res, T(v[l]));
+    }
+
+    return res;
+}
+#else
+// Without std::experimental::simd the kernels run on scalars and rely on the
+// independent accumulators alone
+template<typename T>
+using simd_t = T;
+#endif
+
+template<typename V, typename T>
+    requires std::is_same_v<V, T>
+V load(const T *p)
+{
+    return *p;
+}
+
+template<typename V, typename T>
+    requires std::is_same_v<V, T>
+void store(const V &v, T *p)
+{
+    *p = v;
+}
+
+template<typename V, typename T, typename Op>
+    requires std::is_same_v<V, T>
+T fold_lanes(const V &v, T res, Op op)
+{
+    return op(res, v);
+}
+
+template<typename T>
+constexpr std::size_t simd_width()
+{
+    if constexpr (std::is_same_v<simd_t<T>, T>) {
+        return 1;
+    } else {
+        return simd_t<T>::size();
+    }
+}
+
+// Independent accumulators hide the latency of the folding operation. Small
+// vectors do not have enough blocks to fill more than one.
+template<typename T, std::size_t S>
+inline constexpr std::size_t unroll = std::clamp<std::size_t>(S / simd_width<T>(), 1, 4);
+
+// Value of an operand at i as V: a vector operand is loaded, a scalar is
+// broadcast
+template<typename V, typename E, typename X>
+V lanes(const X &scalar, std::size_t)
+{
+    return V(static_cast<E>(scalar));
+}
+
+template<typename V, typename E, std::size_t S, typename L>
+V lanes(const StaticVector<E, S, L> &vec, std::size_t i)
+{
+    return load<V>(vec.data() + i);
+}
+
+template<typename T>
+std::size_t extent(const T &, std::size_t n)
+{
+    return n;
+}
+
+template<typename T, std::size_t S, typename L>
+std::size_t extent(const StaticVector<T, S, L> &vec, std::size_t n)
+{
+    return std::min(n, vec.size());
+}
+
+// Fold term(i) for i in [0, n) into init with op, which must accept both
+// vectors and scalars. The order of operations is unspecified.
+template<typename T, std::size_t S, typename Term, typename Op>
+T fold(std::size_t n, T init, Term term, Op op)
+{
+    using V = simd_t<T>;
+    constexpr std::size_t W = simd_width<T>();
+    constexpr std::size_t U = unroll<T, S>;
+
+    std::size_t i = 0;
+    T res = init;
+
+    if (n >= W) {
+        V acc[U];
+        for (std::size_t u = 0; u < U; ++u) {
+            acc[u] = V(init);
+        }
+
+        for (; i + U * W <= n; i += U * W) {
+            for (std::size_t u = 0; u < U; ++u) {
+                acc[u] = op(acc[u], term.template operator()<V>(i + u * W));
+            }
+        }
+
+        for (; i + W <= n; i += W) {
+            acc[0] = op(acc[0], term.template operator()<V>(i));
+        }
+
+        for (std::size_t u = 1; u < U; ++u) {
+            acc[0] = op(acc[0], acc[u]);
+        }
+
+        res = fold_lanes(acc[0], res, op);
+    }
+
+    for (; i < n; ++i) {
+        res = op(res, term.template operator()<T>(i));
+    }
+
+    return res;
+}
+
+// dst[i] = term(i) for i in [0, n)
+template<typename T, std::size_t S, typename Term>
+void transform(T *dst, std::size_t n, Term term)
+{
+    using V = simd_t<T>;
+    constexpr std::size_t W = simd_width<T>();
+    std::size_t i = 0;
+
+    for (; i + W <= n; i += W) {
+        store(term.template operator()<V>(i), dst + i);
+    }
+
+    for (; i < n; ++i) {
+        dst[i] = term.template operator()<T>(i);
+    }
+}
+
+struct plus {
+    template<typename V>
+    V operator()(const V &a, const V &b) const
+    {
+        return a + b;
+    }
+};
+
+struct minimum {
+    template<typename V>
+    V operator()(const V &a, const V &b) const
+    {
+        if constexpr (std::is_arithmetic_v<V>) {
+            return b < a ? b : a;
+        } else {
+            return min(a, b);
+        }
+    }
+};
+
+struct maximum {
+    template<typename V>
+    V operator()(const V &a, const V &b) const
+    {
+        if constexpr (std::is_arithmetic_v<V>) {
+            return a < b ? b : a;
+        } else {
+            return max(a, b);
+        }
+    }
+};
+
+} // namespace staticvec::detail
+
+// Reductions and in-place element-wise arithmetic over StaticVectors of
+// arithmetic types, using std::experimental::simd where available. Floating
+// point reductions use several accumulators, so results may differ from a
+// sequential loop by rounding. Binary operations cover the common prefix of
+// their vector operands; min, max and their arg variants of an empty vector
+// are undefined, like front().
+namespace staticvec {
+
+template<detail::numeric T, std::size_t S, typename L>
+T sum(const StaticVector<T, S, L> &v)
+{
+    return detail::fold<T, S>(v.size(), T(0),
+        [&]<typename V>(std::size_t i) { return detail::load<V>(v.data() + i); },
+        detail::plus());
+}
+
+template<detail::numeric T, std::size_t S, typename L>
+T min(const StaticVector<T, S, L> &v)
+{
+    return detail::fold<T, S>(v.size(), v.front(),
+        [&]<typename V>(std::size_t i) { return detail::load<V>(v.data() + i); },
+        detail::minimum());
+}
+
+template<detail::numeric T, std::size_t S, typename L>
+T max(const StaticVector<T, S, L> &v)
+{
+    return detail::fold<T, S>(v.size(), v.front(),
+        [&]<typename V>(std::size_t i) { return detail::load<V>(v.data() + i); },
+        detail::maximum());
+}
+
+template<detail::numeric T, std::size_t S, typename L>
+std::pair<T, T> minmax(const StaticVector<T, S, L> &v)
+{
+    return {staticvec::min(v), staticvec::max(v)};
+}
+
+// Index of the first smallest element
+template<detail::numeric T, std::size_t S, typename L>
+std::size_t argmin(const StaticVector<T, S, L> &v)
+{
+    return std::find(v.data(), v.data() + v.size(), staticvec::min(v)) - v.data();
+}
+
+// Index of the first largest element
+template<detail::numeric T, std::size_t S, typename L>
+std::size_t argmax(const StaticVector<T, S, L> &v)
+{
+    return std::find(v.data(), v.data() + v.size(), staticvec::max(v)) - v.data();
+}
+
+template<detail::numeric T, std::size_t S1, typename L1, std::size_t S2, typename L2>
+T dot(const StaticVector<T, S1, L1> &a, const StaticVector<T, S2, L2> &b)
+{
+    return detail::fold<T, std::min(S1, S2)>(std::min(a.size(), b.size()), T(0),
+        [&]<typename V>(std::size_t i) {
+            return detail::load<V>(a.data() + i) * detail::load<V>(b.data() + i);
+        },
+        detail::plus());
+}
+
+// v += x, for a vector or scalar x
+template<detail::numeric T, std::size_t S, typename L, typename X>
+void add(StaticVector<T, S, L> &v, const X &x)
+{
+    detail::transform<T, S>(v.data(), detail::extent(x, v.size()),
+        [&]<typename V>(std::size_t i) {
+            return detail::load<V>(v.data() + i) + detail::lanes<V, T>(x, i);
+        });
+}
+
+// v *= x, for a vector or scalar x
+template<detail::numeric T, std::size_t S, typename L, typename X>
+void mul(StaticVector<T, S, L> &v, const X &x)
+{
+    detail::transform<T, S>(v.data(), detail::extent(x, v.size()),
+        [&]<typename V>(std::size_t i) {
+            return detail::load<V>(v.data() + i) * detail::lanes<V, T>(x, i);
+        });
+}
+
+// v = v * m + a, for vectors or scalars m and a
+template<detail::numeric T, std::size_t S, typename L, typename M, typename A>
+void fma(StaticVector<T, S, L> &v, const M &m, const A &a)
+{
+    detail::transform<T, S>(v.data(), detail::extent(a, detail::extent(m, v.size())),
+        [&]<typename V>(std::size_t i) {
+            return detail::load<V>(v.data() + i) * detail::lanes<V, T>(m, i) +
+                detail::lanes<V, T>(a, i);
+        });
+}
+
+} // namespace staticvec
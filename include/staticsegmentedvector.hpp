@@ -0,0 +1,526 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <staticvector.hpp>
+
+// Sequence of up to ChunkSize * Chunks elements kept in Chunks in-place
+// StaticVectors. Logical order is kept in a small array of chunk indices, so
+// inserting or erasing in the middle only shifts the elements of one chunk:
+// a full chunk is split into a free one, and only once every chunk is in use
+// are elements pushed through the neighbouring chunks towards the nearest
+// one with room.
+//
+// push_back and emplace_back only move existing elements when the last chunk
+// is full and no free chunk is left. Middle inserts spill rather than take
+// the last free chunk unless every chunk in use is full, so it stays for
+// growth at the back and references stay valid while the container grows
+// there. Indexing walks the chunk sizes and is O(Chunks); iterate, or use
+// segments() to hand whole chunks to algorithms.
+template<typename T, std::size_t ChunkSize, std::size_t Chunks>
+class StaticSegmentedVector {
+    static_assert(ChunkSize >= 2, "chunks must hold at least two elements");
+    static_assert(Chunks >= 1, "at least one chunk is needed");
+
+    using chunk_type = StaticVector<T, ChunkSize>;
+    using index_type = staticvec::detail::offset_t<Chunks>;
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+
+    template<typename U>
+    class segmented_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::remove_const_t<U>;
+        using pointer           = U*;
+        using reference         = U&;
+
+        segmented_iterator()
+            : _parent(nullptr), _chunk(0), _offset(0)
+        {
+
+        }
+
+        template<typename V>
+            requires std::is_same_v<U, const V>
+        segmented_iterator(const segmented_iterator<V> &other)
+            : _parent(other._parent), _chunk(other._chunk), _offset(other._offset)
+        {
+
+        }
+
+        reference operator*() const
+        {
+            return _parent->chunk(_chunk)[_offset];
+        }
+
+        pointer operator->() const
+        {
+            return &_parent->chunk(_chunk)[_offset];
+        }
+
+        segmented_iterator& operator++()
+        {
+            if (++_offset == _parent->chunk(_chunk).size() &&
+                _chunk + 1 < _parent->_order.size()) {
+                _chunk++;
+                _offset = 0;
+            }
+
+            return *this;
+        }
+
+        segmented_iterator operator++(int)
+        {
+            segmented_iterator tmp = *this;
+
+            ++*this;
+            return tmp;
+        }
+
+        segmented_iterator& operator--()
+        {
+            if (_offset == 0) {
+                _chunk--;
+                _offset = _parent->chunk(_chunk).size();
+            }
+
+            _offset--;
+            return *this;
+        }
+
+        segmented_iterator operator--(int)
+        {
+            segmented_iterator tmp = *this;
+
+            --*this;
+            return tmp;
+        }
+
+        friend bool operator ==(const segmented_iterator &a,
+                                const segmented_iterator &b)
+        {
+            return a._chunk == b._chunk && a._offset == b._offset;
+        }
+
+    private:
+        friend StaticSegmentedVector<T, ChunkSize, Chunks>;
+
+        template<typename>
+        friend class segmented_iterator;
+
+        using parent_type = std::conditional_t<std::is_const_v<U>,
+              const StaticSegmentedVector<T, ChunkSize, Chunks>,
+              StaticSegmentedVector<T, ChunkSize, Chunks>>;
+
+        segmented_iterator(parent_type *parent, std::size_t chunk, std::size_t offset)
+            : _parent(parent), _chunk(chunk), _offset(offset)
+        {
+
+        }
+
+        parent_type *_parent;
+        std::size_t _chunk;
+        std::size_t _offset;
+    };
+
+    using iterator = segmented_iterator<T>;
+    using const_iterator = segmented_iterator<const T>;
+
+    StaticSegmentedVector()
+        : _size(0)
+    {
+        for (std::size_t i = Chunks; i > 0; --i) {
+            _free.push_back(static_cast<index_type>(i - 1));
+        }
+    }
+
+    StaticSegmentedVector(std::initializer_list<T> l)
+        : StaticSegmentedVector()
+    {
+        for (const T &val : l) {
+            push_back(val);
+        }
+    }
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return ChunkSize * Chunks;
+    }
+
+    void clear()
+    {
+        while (!_order.empty()) {
+            release_chunk(_order.size() - 1);
+        }
+
+        _size = 0;
+    }
+
+    T& operator[](std::size_t i)
+    {
+        for (std::size_t c = 0;; ++c) {
+            chunk_type &ch = chunk(c);
+
+            if (i < ch.size()) {
+                return ch[i];
+            }
+
+            i -= ch.size();
+        }
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return const_cast<StaticSegmentedVector<T, ChunkSize, Chunks> *>(this)->operator[](i);
+    }
+
+    T& at(std::size_t i)
+    {
+        if (i >= _size) [[unlikely]] {
+            staticvec::detail::out_of_range("StaticSegmentedVector::at");
+        }
+
+        return (*this)[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        return const_cast<StaticSegmentedVector<T, ChunkSize, Chunks> *>(this)->at(i);
+    }
+
+    T& front()
+    {
+        return chunk(0).front();
+    }
+
+    const T& front() const
+    {
+        return chunk(0).front();
+    }
+
+    T& back()
+    {
+        return chunk(_order.size() - 1).back();
+    }
+
+    const T& back() const
+    {
+        return chunk(_order.size() - 1).back();
+    }
+
+    // Number of chunks in use, in logical order
+    std::size_t segment_count() const
+    {
+        return _order.size();
+    }
+
+    std::span<T> segment(std::size_t i)
+    {
+        return std::span<T>(chunk(i).data(), chunk(i).size());
+    }
+
+    std::span<const T> segment(std::size_t i) const
+    {
+        return std::span<const T>(chunk(i).data(), chunk(i).size());
+    }
+
+    // The elements as a range of contiguous spans, one per chunk
+    auto segments()
+    {
+        return std::views::iota(std::size_t(0), segment_count()) |
+            std::views::transform([this](std::size_t i) { return segment(i); });
+    }
+
+    auto segments() const
+    {
+        return std::views::iota(std::size_t(0), segment_count()) |
+            std::views::transform([this](std::size_t i) { return segment(i); });
+    }
+
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args)
+    {
+        if (_size == capacity()) [[unlikely]] {
+            staticvec::detail::overflow(0, "push_back past StaticSegmentedVector size");
+
+            // Saturated: the new element was dropped
+            return back();
+        }
+
+        if (_order.empty() || chunk(_order.size() - 1).size() == ChunkSize) {
+            if (_free.empty()) {
+                return *emplace(cend(), std::forward<Args>(args)...);
+            }
+
+            acquire_chunk(_order.size());
+        }
+
+        T &res = chunk(_order.size() - 1).emplace_back(std::forward<Args>(args)...);
+
+        _size++;
+        return res;
+    }
+
+    T& push_back(const T &val)
+    {
+        return emplace_back(val);
+    }
+
+    T& push_back(T &&val)
+    {
+        return emplace_back(std::move(val));
+    }
+
+    void pop_back()
+    {
+        if (empty()) {
+            return;
+        }
+
+        erase(std::prev(cend()));
+    }
+
+    iterator insert(const_iterator pos, const T &val)
+    {
+        return emplace(pos, val);
+    }
+
+    iterator insert(const_iterator pos, T &&val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    template<typename ...Args>
+    iterator emplace(const_iterator pos, Args&& ...args)
+    {
+        if (_size == capacity()) [[unlikely]] {
+            staticvec::detail::overflow(0, "insert past StaticSegmentedVector size");
+            return end();
+        }
+
+        // The arguments may refer to elements about to be moved
+        T tmp(std::forward<Args>(args)...);
+        std::size_t c = pos._chunk;
+        std::size_t off = pos._offset;
+
+        if (_order.empty()) {
+            acquire_chunk(0);
+        } else if (chunk(c).size() == ChunkSize) {
+            bool appending = off == ChunkSize && c + 1 == _order.size();
+
+            if (off == 0 && c > 0 && chunk(c - 1).size() < ChunkSize) {
+                c--;
+                off = chunk(c).size();
+            } else if (appending && !_free.empty()) {
+                // Start a new chunk rather than splitting
+                acquire_chunk(++c);
+                off = 0;
+            } else if (_free.size() > 1 || (!_free.empty() && !has_room())) {
+                split(c, off);
+            } else {
+                spill(c, off);
+            }
+        }
+
+        chunk(c).emplace(chunk(c).cbegin() + off, std::move(tmp));
+        _size++;
+        return iterator(this, c, off);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        if (pos == cend()) {
+            return end();
+        }
+
+        std::size_t c = pos._chunk;
+        std::size_t off = pos._offset;
+        chunk_type &ch = chunk(c);
+
+        ch.erase(ch.cbegin() + off);
+        _size--;
+
+        if (ch.empty()) {
+            release_chunk(c);
+            off = 0;
+        } else if (off == ch.size()) {
+            c++;
+            off = 0;
+        }
+
+        if (c >= _order.size()) {
+            return end();
+        }
+
+        return iterator(this, c, off);
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, last_chunk(), end_offset());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, last_chunk(), end_offset());
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+private:
+    chunk_type _chunks[Chunks];
+    StaticVector<index_type, Chunks> _order;
+    StaticVector<index_type, Chunks> _free;
+    std::size_t _size;
+
+    chunk_type& chunk(std::size_t c)
+    {
+        return _chunks[_order[c]];
+    }
+
+    const chunk_type& chunk(std::size_t c) const
+    {
+        return _chunks[_order[c]];
+    }
+
+    std::size_t last_chunk() const
+    {
+        return _order.empty() ? 0 : _order.size() - 1;
+    }
+
+    std::size_t end_offset() const
+    {
+        return _order.empty() ? 0 : chunk(_order.size() - 1).size();
+    }
+
+    // Whether a chunk in use is not full, so that spill() can make room
+    bool has_room() const
+    {
+        return _size < _order.size() * ChunkSize;
+    }
+
+    // Put a free chunk at logical position c
+    void acquire_chunk(std::size_t c)
+    {
+        index_type phys = _free.back();
+
+        _free.pop_back();
+        _order.insert(_order.cbegin() + c, phys);
+    }
+
+    void release_chunk(std::size_t c)
+    {
+        chunk(c).clear();
+        _free.push_back(_order[c]);
+        _order.erase(_order.cbegin() + c);
+    }
+
+    // Move the upper half of the full chunk c into a new chunk after it and
+    // adjust the insert position (c, off)
+    void split(std::size_t &c, std::size_t &off)
+    {
+        constexpr std::size_t half = ChunkSize / 2;
+
+        acquire_chunk(c + 1);
+
+        chunk_type &lower = chunk(c);
+        chunk_type &upper = chunk(c + 1);
+
+        upper.append_range(std::ranges::subrange(
+            std::make_move_iterator(lower.begin() + half),
+            std::make_move_iterator(lower.end())));
+        lower.erase(lower.cbegin() + half, lower.cend());
+
+        if (off > half) {
+            c++;
+            off -= half;
+        }
+    }
+
+    // Without a free chunk to spare, shift one element per chunk boundary
+    // from the full chunk c towards the nearest chunk with room
+    void spill(std::size_t &c, std::size_t &off)
+    {
+        for (std::size_t j = c + 1; j < _order.size(); ++j) {
+            if (chunk(j).size() < ChunkSize) {
+                for (; j > c; --j) {
+                    chunk_type &from = chunk(j - 1);
+                    chunk_type &to = chunk(j);
+
+                    to.insert(to.cbegin(), std::move(from.back()));
+                    from.pop_back();
+                }
+
+                return;
+            }
+        }
+
+        // Nothing to the right: make room in the chunk holding the element
+        // just before the insert position and shift to the left
+        if (off == 0) {
+            c--;
+            off = chunk(c).size();
+        }
+
+        std::size_t j = c;
+        while (chunk(j).size() == ChunkSize) {
+            j--;
+        }
+
+        if (j == c) {
+            return;
+        }
+
+        for (; j < c; ++j) {
+            chunk_type &from = chunk(j + 1);
+            chunk_type &to = chunk(j);
+
+            to.push_back(std::move(from.front()));
+            from.erase(from.cbegin());
+        }
+
+        off--;
+    }
+};
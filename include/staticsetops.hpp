@@ -0,0 +1,428 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <staticvector.hpp>
+
+namespace staticvec::detail {
+
+// Size ratio above which merging gives way to galloping search in the larger
+// input
+inline constexpr std::size_t gallop_ratio = 32;
+
+// First position in [first, last) not less than val, probing 1, 2, 4, ...
+// elements ahead before binary searching
+template<typename T>
+const T* gallop(const T *first, const T *last, const T &val)
+{
+    std::size_t step = 1;
+
+    while (step < static_cast<std::size_t>(last - first) && first[step] < val) {
+        first += step;
+        step *= 2;
+    }
+
+    return std::lower_bound(first, first + std::min<std::size_t>(step, last - first), val);
+}
+
+// Emit the elements of a block whose bits are set in mask to out from k on.
+// Returns the new count; out is only used when Write is true.
+template<bool Write, typename T>
+std::size_t emit_mask(const T *block, unsigned mask, T *out, std::size_t k)
+{
+    if constexpr (Write) {
+        for (; mask != 0; mask &= mask - 1) {
+            out[k++] = block[std::countr_zero(mask)];
+        }
+
+        return k;
+    } else {
+        return k + std::popcount(mask);
+    }
+}
+
+// Block compare intersection: every element of a W wide block of a is
+// compared with every element of a block of b through lane rotations, and the
+// block with the smaller maximum advances. Returns the number of matches and
+// leaves i and j where the scalar tail continues.
+#ifdef __AVX2__
+template<bool Write>
+std::size_t intersect_blocks(const std::uint32_t *a, std::size_t na,
+                             const std::uint32_t *b, std::size_t nb,
+                             std::uint32_t *out, std::size_t &i, std::size_t &j)
+{
+    const __m256i rot = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    std::size_t k = 0;
+
+    while (i + 8 <= na && j + 8 <= nb) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + j));
+        __m256i hits = _mm256_cmpeq_epi32(va, vb);
+
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rot);
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(hits));
+        k = emit_mask<Write>(a + i, mask, out, k);
+
+        std::uint32_t amax = a[i + 7];
+        std::uint32_t bmax = b[j + 7];
+        i += amax <= bmax ? 8 : 0;
+        j += bmax <= amax ? 8 : 0;
+    }
+
+    return k;
+}
+
+template<bool Write>
+std::size_t intersect_blocks(const std::uint64_t *a, std::size_t na,
+                             const std::uint64_t *b, std::size_t nb,
+                             std::uint64_t *out, std::size_t &i, std::size_t &j)
+{
+    std::size_t k = 0;
+
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + j));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(va, vb),
+                            _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x39))),
+            _mm256_or_si256(_mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x4e)),
+                            _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x93))));
+
+        unsigned mask = _mm256_movemask_pd(_mm256_castsi256_pd(hits));
+        k = emit_mask<Write>(a + i, mask, out, k);
+
+        std::uint64_t amax = a[i + 3];
+        std::uint64_t bmax = b[j + 3];
+        i += amax <= bmax ? 4 : 0;
+        j += bmax <= amax ? 4 : 0;
+    }
+
+    return k;
+}
+#elif defined(__SSE2__)
+template<bool Write>
+std::size_t intersect_blocks(const std::uint32_t *a, std::size_t na,
+                             const std::uint32_t *b, std::size_t nb,
+                             std::uint32_t *out, std::size_t &i, std::size_t &j)
+{
+    std::size_t k = 0;
+
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+        unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(hits));
+        k = emit_mask<Write>(a + i, mask, out, k);
+
+        std::uint32_t amax = a[i + 3];
+        std::uint32_t bmax = b[j + 3];
+        i += amax <= bmax ? 4 : 0;
+        j += bmax <= amax ? 4 : 0;
+    }
+
+    return k;
+}
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+template<typename T>
+concept block_intersectable = requires(const T *p, T *out, std::size_t n) {
+    intersect_blocks<true>(p, n, p, n, out, n, n);
+};
+#else
+template<typename T>
+concept block_intersectable = false;
+#endif
+
+// Intersection of two strictly increasing arrays, written to out unless
+// Write is false, in which case out may be null. Returns the number of
+// common elements.
+template<bool Write, typename T>
+std::size_t intersect(const T *a, std::size_t na, const T *b, std::size_t nb, T *out)
+{
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    std::size_t k = 0;
+
+    if (nb / gallop_ratio > na) {
+        const T *pos = b;
+        const T *end = b + nb;
+
+        for (std::size_t i = 0; i < na && pos != end; ++i) {
+            pos = gallop(pos, end, a[i]);
+            if (pos != end && *pos == a[i]) {
+                if constexpr (Write) {
+                    out[k] = a[i];
+                }
+
+                k++;
+                pos++;
+            }
+        }
+
+        return k;
+    }
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    if constexpr (block_intersectable<T>) {
+        k = intersect_blocks<Write>(a, na, b, nb, out, i, j);
+    }
+
+    while (i < na && j < nb) {
+        if (a[i] == b[j]) {
+            if constexpr (Write) {
+                out[k] = a[i];
+            }
+
+            k++;
+        }
+
+        T x = a[i];
+        T y = b[j];
+        i += x <= y;
+        j += y <= x;
+    }
+
+    return k;
+}
+
+template<typename T>
+T* copy_run(const T *first, const T *last, T *out)
+{
+    std::memcpy(out, first, (last - first) * sizeof(T));
+    return out + (last - first);
+}
+
+// Union of two strictly increasing arrays, returns one past the last element
+// written
+template<typename T>
+T* unite(const T *a, std::size_t na, const T *b, std::size_t nb, T *out)
+{
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    const T *pos = b;
+    const T *end = b + nb;
+
+    if (nb / gallop_ratio > na) {
+        // Copy the runs of b between elements of a in bulk
+        for (std::size_t i = 0; i < na; ++i) {
+            const T *next = gallop(pos, end, a[i]);
+
+            out = copy_run(pos, next, out);
+            *out++ = a[i];
+            pos = next != end && *next == a[i] ? next + 1 : next;
+        }
+
+        return copy_run(pos, end, out);
+    }
+
+    const T *apos = a;
+    const T *aend = a + na;
+
+    while (apos != aend && pos != end) {
+        T x = *apos;
+        T y = *pos;
+
+        *out++ = x <= y ? x : y;
+        apos += x <= y;
+        pos += y <= x;
+    }
+
+    out = copy_run(apos, aend, out);
+    return copy_run(pos, end, out);
+}
+
+// Elements of a not in b, both strictly increasing. Returns one past the last
+// element written.
+template<typename T>
+T* subtract(const T *a, std::size_t na, const T *b, std::size_t nb, T *out)
+{
+    const T *apos = a;
+    const T *aend = a + na;
+    const T *bpos = b;
+    const T *bend = b + nb;
+
+    if (na / gallop_ratio > nb) {
+        // Few elements to remove: copy the runs of a between them in bulk
+        for (; bpos != bend; ++bpos) {
+            const T *next = gallop(apos, aend, *bpos);
+
+            out = copy_run(apos, next, out);
+            apos = next != aend && *next == *bpos ? next + 1 : next;
+        }
+
+        return copy_run(apos, aend, out);
+    }
+
+    if (nb / gallop_ratio > na) {
+        for (; apos != aend; ++apos) {
+            bpos = gallop(bpos, bend, *apos);
+            if (bpos == bend || *bpos != *apos) {
+                *out++ = *apos;
+            }
+        }
+
+        return out;
+    }
+
+    while (apos != aend && bpos != bend) {
+        if (*apos < *bpos) {
+            *out++ = *apos++;
+        } else {
+            apos += *apos == *bpos;
+            bpos++;
+        }
+    }
+
+    return copy_run(apos, aend, out);
+}
+
+// Output iterator dropping whatever does not fit in a saturated destination
+template<typename T, std::size_t S, typename L>
+struct saturating_writer {
+    using difference_type = std::ptrdiff_t;
+
+    StaticVector<T, S, L> *vec;
+
+    saturating_writer& operator*()
+    {
+        return *this;
+    }
+
+    saturating_writer& operator=(const T &val)
+    {
+        if (vec->size() < S) {
+            vec->push_back(val);
+        }
+
+        return *this;
+    }
+
+    saturating_writer& operator++()
+    {
+        return *this;
+    }
+
+    saturating_writer operator++(int)
+    {
+        return *this;
+    }
+};
+
+// Replace the contents of out with a set operation producing at most bound
+// elements. When the bound does not fit, the exact size is computed first so
+// capacity is checked once either way, and before out is cleared.
+template<typename T, std::size_t S, typename L, typename Kernel, typename Count,
+         typename Fallback>
+void emit_set(StaticVector<T, S, L> &out, std::size_t bound, Kernel &&kernel,
+              Count &&count, Fallback &&fallback, const char *what)
+{
+    if (bound > S && count() > S) [[unlikely]] {
+        staticvec::detail::overflow(S, what);
+
+        // Saturated: keep the first S elements of the result
+        out.clear();
+        fallback(saturating_writer<T, S, L>{&out});
+        return;
+    }
+
+    out.clear();
+
+    T *first = out.spare_capacity().data();
+    out.commit(kernel(first) - first);
+}
+
+} // namespace staticvec::detail
+
+// Set operations over sorted StaticVectors of unique elements. The result
+// replaces the contents of out, which must not be one of the inputs.
+// Intersections of uint32_t and uint64_t elements compare whole SSE2/AVX2
+// blocks at a time, and all operations switch to galloping search when one
+// input is much larger than the other.
+namespace staticvec {
+
+template<typename T, std::size_t S1, typename L1, std::size_t S2, typename L2>
+    requires detail::overwritable<T>
+std::size_t intersect_count(const StaticVector<T, S1, L1> &a,
+                            const StaticVector<T, S2, L2> &b)
+{
+    return detail::intersect<false>(a.data(), a.size(), b.data(), b.size(),
+                                    static_cast<T *>(nullptr));
+}
+
+template<typename T, std::size_t S1, typename L1, std::size_t S2, typename L2,
+         std::size_t SD, typename LD>
+    requires detail::overwritable<T>
+void set_intersection(const StaticVector<T, S1, L1> &a,
+                      const StaticVector<T, S2, L2> &b,
+                      StaticVector<T, SD, LD> &out)
+{
+    detail::emit_set(out, std::min(a.size(), b.size()),
+        [&](T *dst) {
+            return dst + detail::intersect<true>(a.data(), a.size(),
+                                                 b.data(), b.size(), dst);
+        },
+        [&] { return intersect_count(a, b); },
+        [&](auto it) { std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), it); },
+        "set_intersection past StaticVector size");
+}
+
+template<typename T, std::size_t S1, typename L1, std::size_t S2, typename L2,
+         std::size_t SD, typename LD>
+    requires detail::overwritable<T>
+void set_union(const StaticVector<T, S1, L1> &a,
+               const StaticVector<T, S2, L2> &b,
+               StaticVector<T, SD, LD> &out)
+{
+    detail::emit_set(out, a.size() + b.size(),
+        [&](T *dst) {
+            return detail::unite(a.data(), a.size(), b.data(), b.size(), dst);
+        },
+        [&] { return a.size() + b.size() - intersect_count(a, b); },
+        [&](auto it) { std::set_union(a.begin(), a.end(), b.begin(), b.end(), it); },
+        "set_union past StaticVector size");
+}
+
+template<typename T, std::size_t S1, typename L1, std::size_t S2, typename L2,
+         std::size_t SD, typename LD>
+    requires detail::overwritable<T>
+void set_difference(const StaticVector<T, S1, L1> &a,
+                    const StaticVector<T, S2, L2> &b,
+                    StaticVector<T, SD, LD> &out)
+{
+    detail::emit_set(out, a.size(),
+        [&](T *dst) {
+            return detail::subtract(a.data(), a.size(), b.data(), b.size(), dst);
+        },
+        [&] { return a.size() - intersect_count(a, b); },
+        [&](auto it) { std::set_difference(a.begin(), a.end(), b.begin(), b.end(), it); },
+        "set_difference past StaticVector size");
+}
+
+} // namespace staticvec
@@ -0,0 +1,236 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <staticvector.hpp>
+
+namespace staticvec::detail {
+
+// std::hardware_destructive_interference_size is not ABI stable across
+// compiler flags, so headers use a fixed value
+inline constexpr std::size_t cache_line = 64;
+
+// Per thread starting point for claiming a reader pin, so threads usually
+// each keep to their own cache line
+inline std::size_t reader_home()
+{
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t home = next.fetch_add(1, std::memory_order_relaxed);
+
+    return home;
+}
+
+} // namespace staticvec::detail
+
+// Read-mostly StaticVector published RCU style. Writers build the next
+// version in one of N buffers and publish it with a single atomic store.
+// Readers never block or allocate: read() records the buffer it uses in one
+// of Readers cache line sized pins, normally the calling thread's own, so
+// readers do not share any written cache line. When every pin is held, e.g.
+// with more reading threads than Readers, read() counts itself in a shared
+// per-buffer counter instead, which is correct but contended. Size Readers
+// for the expected number of reading threads.
+//
+// The writer only reuses buffers nobody holds, so it waits while every spare
+// buffer is still held by a ReadHandle.
+template<typename T, std::size_t S, std::size_t N = 2, std::size_t Readers = 16>
+class StaticVectorSnapshot {
+    static_assert(N >= 2, "at least two buffers are needed");
+    static_assert(Readers >= 1, "at least one reader pin is needed");
+
+    struct alignas(staticvec::detail::cache_line) Slot {
+        // Readers that found no free pin
+        mutable std::atomic<std::uint32_t> shared_readers{0};
+        alignas(staticvec::detail::cache_line) StaticVector<T, S> vec;
+    };
+
+    // Index + 1 of the buffer a reader uses, or 0 when free
+    struct alignas(staticvec::detail::cache_line) Pin {
+        std::atomic<std::size_t> buffer{0};
+    };
+
+public:
+    // Consistent view of one published version, valid until destroyed
+    class ReadHandle {
+    public:
+        ReadHandle(ReadHandle &&other)
+            : _pin(std::exchange(other._pin, nullptr)),
+              _slot(std::exchange(other._slot, nullptr))
+        {
+
+        }
+
+        ReadHandle(const ReadHandle &) = delete;
+        ReadHandle& operator=(const ReadHandle &) = delete;
+
+        ~ReadHandle()
+        {
+            if (_pin) {
+                _pin->buffer.store(0, std::memory_order_release);
+            } else if (_slot) {
+                _slot->shared_readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        const StaticVector<T, S>& operator*() const
+        {
+            return _slot->vec;
+        }
+
+        const StaticVector<T, S>* operator->() const
+        {
+            return &_slot->vec;
+        }
+
+    private:
+        friend StaticVectorSnapshot<T, S, N, Readers>;
+
+        // Without a pin the handle is counted in the slot's shared_readers
+        ReadHandle(Pin *pin, const Slot *slot)
+            : _pin(pin), _slot(slot)
+        {
+
+        }
+
+        Pin *_pin;
+        const Slot *_slot;
+    };
+
+    StaticVectorSnapshot()
+        : _current(0)
+    {
+
+    }
+
+    StaticVectorSnapshot(const StaticVector<T, S> &initial)
+        : StaticVectorSnapshot()
+    {
+        _slots[0].vec = initial;
+    }
+
+    StaticVectorSnapshot(const StaticVectorSnapshot<T, S, N, Readers> &) = delete;
+    StaticVectorSnapshot<T, S, N, Readers>& operator=(
+        const StaticVectorSnapshot<T, S, N, Readers> &) = delete;
+
+    ReadHandle read() const
+    {
+        std::size_t home = staticvec::detail::reader_home();
+
+        // Claim a free pin, starting with this thread's own. Another handle
+        // of the same thread or a thread sharing the pin moves us on.
+        for (std::size_t i = 0; i < Readers; ++i) {
+            Pin &pin = _pins[(home + i) % Readers];
+            std::size_t idx = _current.load(std::memory_order_acquire);
+            std::size_t free = 0;
+
+            if (pin.buffer.load(std::memory_order_relaxed) == 0 &&
+                pin.buffer.compare_exchange_strong(free, idx + 1,
+                                                   std::memory_order_seq_cst)) {
+                // Make sure the pinned buffer is still the published one, so
+                // a writer cannot have started reusing it
+                for (;;) {
+                    std::size_t now = _current.load(std::memory_order_seq_cst);
+
+                    if (now == idx) {
+                        return ReadHandle(&pin, &_slots[idx]);
+                    }
+
+                    idx = now;
+                    pin.buffer.store(idx + 1, std::memory_order_seq_cst);
+                }
+            }
+        }
+
+        // Every pin is held: count this reader in the buffer itself. The
+        // loop only repeats when a writer published in between.
+        for (;;) {
+            std::size_t idx = _current.load(std::memory_order_acquire);
+            const Slot &slot = _slots[idx];
+
+            slot.shared_readers.fetch_add(1, std::memory_order_seq_cst);
+            if (_current.load(std::memory_order_seq_cst) == idx) {
+                return ReadHandle(nullptr, &slot);
+            }
+
+            slot.shared_readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Publish a copy of the current version modified by f. Writers are
+    // serialized; readers keep seeing the previous version until f returns.
+    template<typename F>
+    void update(F &&f)
+    {
+        std::lock_guard<std::mutex> lock(_write_lock);
+        std::size_t cur = _current.load(std::memory_order_relaxed);
+        Slot &next = acquire_spare(cur);
+
+        next.vec = _slots[cur].vec;
+        std::forward<F>(f)(next.vec);
+        publish(next);
+    }
+
+    void store(const StaticVector<T, S> &vec)
+    {
+        std::lock_guard<std::mutex> lock(_write_lock);
+        Slot &next = acquire_spare(_current.load(std::memory_order_relaxed));
+
+        next.vec = vec;
+        publish(next);
+    }
+
+    void store(StaticVector<T, S> &&vec)
+    {
+        std::lock_guard<std::mutex> lock(_write_lock);
+        Slot &next = acquire_spare(_current.load(std::memory_order_relaxed));
+
+        next.vec = std::move(vec);
+        publish(next);
+    }
+
+private:
+    Slot _slots[N];
+    mutable Pin _pins[Readers];
+    alignas(staticvec::detail::cache_line) std::atomic<std::size_t> _current;
+    std::mutex _write_lock;
+
+    bool pinned(std::size_t idx) const
+    {
+        if (_slots[idx].shared_readers.load(std::memory_order_seq_cst) != 0) {
+            return true;
+        }
+
+        for (const Pin &pin : _pins) {
+            if (pin.buffer.load(std::memory_order_seq_cst) == idx + 1) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Find a buffer other than cur that no reader has pinned
+    Slot& acquire_spare(std::size_t cur)
+    {
+        for (std::size_t i = 1;; ++i) {
+            std::size_t idx = (cur + i) % N;
+
+            if (idx != cur && !pinned(idx)) {
+                return _slots[idx];
+            }
+
+            if (i % N == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void publish(Slot &slot)
+    {
+        _current.store(&slot - _slots, std::memory_order_seq_cst);
+    }
+};
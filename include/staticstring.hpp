@@ -0,0 +1,514 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <staticvector.hpp>
+
+namespace staticvec::detail {
+
+// Index of the first character of s that is (or with Match false, is not) in
+// set, or npos
+template<bool Match>
+std::size_t find_of(std::string_view s, std::string_view set, std::size_t pos)
+{
+    if (Match && set.size() == 1) {
+        if (pos >= s.size()) {
+            return std::string_view::npos;
+        }
+
+        auto *hit = static_cast<const char *>(
+            std::memchr(s.data() + pos, set[0], s.size() - pos));
+        return hit ? hit - s.data() : std::string_view::npos;
+    }
+
+#ifdef __SSE2__
+    if (set.size() <= 8) {
+        __m128i needles[8];
+        for (std::size_t i = 0; i < set.size(); ++i) {
+            needles[i] = _mm_set1_epi8(set[i]);
+        }
+
+        for (; pos + 16 <= s.size(); pos += 16) {
+            __m128i block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(s.data() + pos));
+            __m128i hits = _mm_setzero_si128();
+
+            for (std::size_t i = 0; i < set.size(); ++i) {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[i]));
+            }
+
+            unsigned mask = _mm_movemask_epi8(hits);
+            if (!Match) {
+                mask ^= 0xffff;
+            }
+
+            if (mask != 0) {
+                return pos + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif
+
+    std::uint64_t table[4] = {};
+    for (unsigned char c : set) {
+        table[c >> 6] |= std::uint64_t(1) << (c & 63);
+    }
+
+    for (; pos < s.size(); ++pos) {
+        unsigned char c = s[pos];
+
+        if (((table[c >> 6] >> (c & 63)) & 1) == Match) {
+            return pos;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+} // namespace staticvec::detail
+
+// Fixed capacity string of at most N characters built on StaticVector. There
+// is always room for the terminating NUL, so c_str() never allocates or fails.
+template<std::size_t N>
+class StaticString {
+public:
+    using value_type      = char;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = char&;
+    using const_reference = const char&;
+    using pointer         = char*;
+    using const_pointer   = const char*;
+    using iterator        = char*;
+    using const_iterator  = const char*;
+
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    StaticString()
+    {
+        terminate();
+    }
+
+    // Only the characters are copied, so the NUL is written again
+    StaticString(const StaticString<N> &other)
+        : _chars(other._chars)
+    {
+        terminate();
+    }
+
+    StaticString(StaticString<N> &&other)
+        : _chars(std::move(other._chars))
+    {
+        terminate();
+        other.terminate();
+    }
+
+    StaticString<N>& operator=(const StaticString<N> &other)
+    {
+        _chars = other._chars;
+        terminate();
+        return *this;
+    }
+
+    StaticString<N>& operator=(StaticString<N> &&other)
+    {
+        _chars = std::move(other._chars);
+        terminate();
+        other.terminate();
+        return *this;
+    }
+
+    StaticString(std::string_view sv)
+        : StaticString()
+    {
+        append(sv);
+    }
+
+    // Character arrays that always fit are checked at compile time. Larger
+    // ones go through the pointer constructor, which checks the actual
+    // length. The text ends at the first NUL.
+    template<std::size_t M>
+        requires (M - 1 <= N)
+    StaticString(const char (&s)[M])
+        : StaticString()
+    {
+        std::string_view sv(s, M - 1);
+        append(sv.substr(0, sv.find('\0')));
+    }
+
+    template<typename P>
+        requires std::is_same_v<P, const char *> || std::is_same_v<P, char *>
+    StaticString(P s)
+        : StaticString(std::string_view(s))
+    {
+
+    }
+
+    StaticString(std::size_t count, char ch)
+        : StaticString()
+    {
+        append(count, ch);
+    }
+
+    StaticString<N>& operator=(std::string_view sv)
+    {
+        clear();
+        return append(sv);
+    }
+
+    StaticString<N>& operator=(const char *s)
+    {
+        return *this = std::string_view(s);
+    }
+
+    std::size_t size() const
+    {
+        return _chars.size();
+    }
+
+    std::size_t length() const
+    {
+        return _chars.size();
+    }
+
+    std::size_t max_size() const
+    {
+        return N;
+    }
+
+    std::size_t capacity() const
+    {
+        return N;
+    }
+
+    bool empty() const
+    {
+        return _chars.empty();
+    }
+
+    void clear()
+    {
+        _chars.clear();
+        terminate();
+    }
+
+    char* data()
+    {
+        return _chars.data();
+    }
+
+    const char* data() const
+    {
+        return _chars.data();
+    }
+
+    const char* c_str() const
+    {
+        return _chars.data();
+    }
+
+    std::string_view view() const
+    {
+        return std::string_view(data(), size());
+    }
+
+    operator std::string_view() const
+    {
+        return view();
+    }
+
+    char& operator[](std::size_t i)
+    {
+        return _chars[i];
+    }
+
+    const char& operator[](std::size_t i) const
+    {
+        return _chars[i];
+    }
+
+    char& at(std::size_t i)
+    {
+        return _chars.at(i);
+    }
+
+    const char& at(std::size_t i) const
+    {
+        return _chars.at(i);
+    }
+
+    char& front()
+    {
+        return _chars.front();
+    }
+
+    const char& front() const
+    {
+        return _chars.front();
+    }
+
+    char& back()
+    {
+        return _chars.back();
+    }
+
+    const char& back() const
+    {
+        return _chars.back();
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + size();
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    void push_back(char ch)
+    {
+        if (0 == room_for(1, "push_back past StaticString size")) {
+            return;
+        }
+
+        _chars.push_back(ch);
+        terminate();
+    }
+
+    void pop_back()
+    {
+        _chars.pop_back();
+        terminate();
+    }
+
+    StaticString<N>& append(std::string_view sv)
+    {
+        std::size_t count = room_for(sv.size(), "append past StaticString size");
+
+        _chars.append_range(sv.substr(0, count));
+        terminate();
+        return *this;
+    }
+
+    StaticString<N>& append(std::size_t count, char ch)
+    {
+        count = room_for(count, "append past StaticString size");
+
+        _chars.insert(_chars.cend(), count, ch);
+        terminate();
+        return *this;
+    }
+
+    StaticString<N>& operator+=(std::string_view sv)
+    {
+        return append(sv);
+    }
+
+    StaticString<N>& operator+=(char ch)
+    {
+        push_back(ch);
+        return *this;
+    }
+
+    StaticString<N>& insert(std::size_t pos, std::string_view sv)
+    {
+        check_pos(pos, "StaticString::insert");
+
+        if (sv.data() < end() && sv.data() + sv.size() > begin()) {
+            // Inserting part of this string: copy it before shifting
+            StaticString<N> tmp(sv);
+            return insert(pos, tmp.view());
+        }
+
+        std::size_t count = room_for(sv.size(), "insert past StaticString size");
+
+        _chars.insert(_chars.cbegin() + pos, sv.begin(), sv.begin() + count);
+        terminate();
+        return *this;
+    }
+
+    StaticString<N>& erase(std::size_t pos = 0, std::size_t count = npos)
+    {
+        check_pos(pos, "StaticString::erase");
+
+        count = std::min(count, size() - pos);
+        _chars.erase(_chars.cbegin() + pos, _chars.cbegin() + pos + count);
+        terminate();
+        return *this;
+    }
+
+    void resize(std::size_t count, char ch = '\0')
+    {
+        if (count <= size()) {
+            erase(count);
+        } else {
+            append(count - size(), ch);
+        }
+    }
+
+    // Unlike std::string, substr returns a view into this string
+    std::string_view substr(std::size_t pos = 0, std::size_t count = npos) const
+    {
+        check_pos(pos, "StaticString::substr");
+        return view().substr(pos, count);
+    }
+
+    std::size_t find(std::string_view sv, std::size_t pos = 0) const
+    {
+        if (sv.size() == 1) {
+            return find(sv[0], pos);
+        }
+
+        return view().find(sv, pos);
+    }
+
+    std::size_t find(char ch, std::size_t pos = 0) const
+    {
+        return staticvec::detail::find_of<true>(view(), std::string_view(&ch, 1), pos);
+    }
+
+    std::size_t rfind(std::string_view sv, std::size_t pos = npos) const
+    {
+        return view().rfind(sv, pos);
+    }
+
+    std::size_t rfind(char ch, std::size_t pos = npos) const
+    {
+        return view().rfind(ch, pos);
+    }
+
+    std::size_t find_first_of(std::string_view set, std::size_t pos = 0) const
+    {
+        return staticvec::detail::find_of<true>(view(), set, pos);
+    }
+
+    std::size_t find_first_not_of(std::string_view set, std::size_t pos = 0) const
+    {
+        return staticvec::detail::find_of<false>(view(), set, pos);
+    }
+
+    std::size_t find_last_of(std::string_view set, std::size_t pos = npos) const
+    {
+        return view().find_last_of(set, pos);
+    }
+
+    bool contains(std::string_view sv) const
+    {
+        return find(sv) != npos;
+    }
+
+    bool starts_with(std::string_view sv) const
+    {
+        return view().starts_with(sv);
+    }
+
+    bool ends_with(std::string_view sv) const
+    {
+        return view().ends_with(sv);
+    }
+
+    int compare(std::string_view sv) const
+    {
+        return view().compare(sv);
+    }
+
+    friend bool operator ==(const StaticString<N> &a, std::string_view b)
+    {
+        return a.view() == b;
+    }
+
+    friend std::strong_ordering operator <=>(const StaticString<N> &a,
+                                             std::string_view b)
+    {
+        return a.view() <=> b;
+    }
+
+private:
+    StaticVector<char, N + 1> _chars;
+
+    std::size_t room_for(std::size_t count, const char *what) const
+    {
+        std::size_t room = N - size();
+
+        if (count <= room) [[likely]] {
+            return count;
+        }
+
+        return staticvec::detail::overflow(room, what);
+    }
+
+    void check_pos(std::size_t pos, const char *what) const
+    {
+        if (pos > size()) [[unlikely]] {
+            staticvec::detail::out_of_range(what);
+        }
+    }
+
+    // The NUL lives in the spare slot past the last character
+    void terminate()
+    {
+        _chars.data()[_chars.size()] = '\0';
+    }
+};
+
+template<std::size_t N>
+struct std::hash<StaticString<N>> {
+    std::size_t operator()(const StaticString<N> &s) const noexcept
+    {
+        return std::hash<std::string_view>()(s.view());
+    }
+};
+
+#ifdef __cpp_lib_format
+template<std::size_t N>
+struct std::formatter<StaticString<N>, char>
+    : std::formatter<std::string_view, char> {
+    auto format(const StaticString<N> &s, std::format_context &ctx) const
+    {
+        return std::formatter<std::string_view, char>::format(s.view(), ctx);
+    }
+};
+#endif
+
+#ifdef STATICVEC_SUPPORT_IOSTREAM
+template<std::size_t N>
+std::ostream& operator<<(std::ostream &os, const StaticString<N> &s)
+{
+    return os << s.view();
+}
+#endif
@@ -1,220 +1,330 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <stdexcept>
 #include <memory>
 #include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 #ifdef STATICVEC_SUPPORT_IOSTREAM
+#include <locale>
 #include <ostream>
 #endif
 
-template<typename T, std::size_t S>
-class StaticVector {
-public:
-    using value_type = T;
-
-    class const_iterator;
-
-    class iterator {
-    public:
-        using interator_category = std::contiguous_iterator_tag;
-        using difference_type    = std::ptrdiff_t;
-        using value_type         = T;
-        using pointer            = T*;
-        using reference          = T&;
+#if __cplusplus > 202002L && __has_include(<expected>)
+#include <expected>
+#endif
 
-        iterator(const iterator &it) = default;
-        iterator(iterator &&it) = default;
-        iterator& operator=(const iterator &it) = default;
-        iterator& operator=(iterator &&it) = default;
+#if __cplusplus > 202002L && __has_include(<format>)
+#include <format>
+#endif
 
-        bool operator ==(const iterator &it) const
-        {
-            return (_parent == it._parent) &&
-                (_index == it._index);
-        }
+// What a mutating operation does when the elements do not fit. THROW raises
+// std::length_error (falling back to ABORT without exceptions), ABORT calls
+// std::abort() and SATURATE stores as many elements as fit and silently drops
+// the rest. Every translation unit of a program must use the same policy.
+#define STATICVEC_OVERFLOW_THROW    1
+#define STATICVEC_OVERFLOW_ABORT    2
+#define STATICVEC_OVERFLOW_SATURATE 3
 
-        bool operator !=(const iterator &it) const
-        {
-            return (_parent != it._parent) ||
-                (_index != it._index);
-        }
+#ifndef STATICVEC_OVERFLOW_POLICY
+#define STATICVEC_OVERFLOW_POLICY STATICVEC_OVERFLOW_THROW
+#endif
 
-        reference operator*()
-        {
-            return _parent->at(_index);
-        }
+// When at() (STATICVEC_AT_CHECK) and operator[] (STATICVEC_INDEX_CHECK)
+// validate their index. DEBUG checks only when NDEBUG is not defined. A failed
+// check throws std::out_of_range under the THROW policy and aborts otherwise.
+#define STATICVEC_CHECK_NEVER  0
+#define STATICVEC_CHECK_ALWAYS 1
+#define STATICVEC_CHECK_DEBUG  2
 
-        pointer operator->()
-        {
-            return &_parent->at(_index);
-        }
+#ifndef STATICVEC_AT_CHECK
+#define STATICVEC_AT_CHECK STATICVEC_CHECK_ALWAYS
+#endif
 
-        iterator& operator++()
-        {
-            if (_index < _parent->size()) {
-                _index++;
-            }
+#ifndef STATICVEC_INDEX_CHECK
+#define STATICVEC_INDEX_CHECK STATICVEC_CHECK_NEVER
+#endif
 
-            return *this;
-        }
+namespace staticvec {
+
+// A type is trivially relocatable when moving it to a new address and
+// destroying the source is equivalent to copying its bytes (P1144). Trivially
+// copyable types qualify automatically; other types may opt in by
+// specializing this trait. Note that libstdc++'s std::string keeps a pointer
+// into itself and must not be marked.
+template<typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template<typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>>
+    : is_trivially_relocatable<D> {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// std::hash<StaticVector<T>> hashes the elements' bytes at once when equal
+// values of T always have equal bytes and no std::hash<T> needs to be
+// honoured. That holds for integers, enums, pointers and std::byte; other
+// types with a bytewise equality and hash may opt in by specializing this
+// trait.
+template<typename T>
+struct is_bytewise_hashable
+    : std::bool_constant<(std::is_integral_v<T> || std::is_enum_v<T> ||
+                          std::is_pointer_v<T>) &&
+                         std::has_unique_object_representations_v<T>> {};
+
+template<typename T>
+inline constexpr bool is_bytewise_hashable_v = is_bytewise_hashable<T>::value;
+
+enum class SizePosition {
+    front,
+    back,
+};
 
-        iterator operator++(int)
-        {
-            iterator tmp = *this;
+// Layout option aligning a StaticVector to A bytes (typically the cache line
+// size). The size is a hot header in front of the elements unless P is
+// SizePosition::back. sizeof() is a multiple of A, so adjacent vectors in an
+// array never share a line.
+template<std::size_t A, SizePosition P = SizePosition::front>
+struct Align {
+    static_assert(A != 0 && (A & (A - 1)) == 0, "alignment must be a power of two");
 
-            if (_index < _parent->size()) {
-                _index++;
-            }
+    static constexpr std::size_t alignment = A;
+    static constexpr SizePosition size_position = P;
+};
 
-            return tmp;
-        }
+// Elements aligned for T followed by the size
+struct DefaultLayout {
+    static constexpr std::size_t alignment = 1;
+    static constexpr SizePosition size_position = SizePosition::back;
+};
 
-        iterator& operator--()
-        {
-            if (_index > 0) {
-                _index--;
-            }
+enum class errc {
+    capacity_exceeded = 1,
+};
 
-            return *this;
-        }
+// Tag selecting the range constructor; std::from_range where the standard
+// library has it
+#ifdef __cpp_lib_containers_ranges
+using std::from_range_t;
+using std::from_range;
+#else
+struct from_range_t {
+    explicit from_range_t() = default;
+};
 
-        iterator& operator--(int)
-        {
-            iterator tmp = *this;
+inline constexpr from_range_t from_range{};
+#endif
 
-            if (_index > 0) {
-                _index--;
-            }
+namespace detail {
 
-            return tmp;
-        }
+constexpr bool check_enabled(int mode)
+{
+#ifdef NDEBUG
+    return STATICVEC_CHECK_ALWAYS == mode;
+#else
+    return STATICVEC_CHECK_NEVER != mode;
+#endif
+}
 
-        iterator& operator+=(difference_type n)
-        {
-            if (n < 0) {
-                return (*this) -= -n;
-            }
+[[noreturn, gnu::cold, gnu::noinline]]
+inline void out_of_range(const char *what)
+{
+#if defined(__cpp_exceptions) && \
+    STATICVEC_OVERFLOW_POLICY == STATICVEC_OVERFLOW_THROW
+    throw std::out_of_range(what);
+#else
+    (void)what;
+    std::abort();
+#endif
+}
 
-            difference_type amnt = std::min(
-                    _parent->size() - _index,
-                    static_cast<std::size_t>(n));
+// Called when only room of the requested elements fit. Returns how many may
+// be stored; only the SATURATE policy returns at all.
+#if STATICVEC_OVERFLOW_POLICY == STATICVEC_OVERFLOW_SATURATE
+[[gnu::cold]]
+inline std::size_t overflow(std::size_t room, const char *)
+{
+    return room;
+}
+#else
+[[noreturn, gnu::cold, gnu::noinline]]
+inline std::size_t overflow(std::size_t, const char *what)
+{
+#if defined(__cpp_exceptions) && \
+    STATICVEC_OVERFLOW_POLICY == STATICVEC_OVERFLOW_THROW
+    throw std::length_error(what);
+#else
+    (void)what;
+    std::abort();
+#endif
+}
+#endif
 
-            _index += amnt;
-            return *this;
-        }
+template<typename R, typename T>
+concept container_compatible_range =
+    std::ranges::input_range<R> &&
+    std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+// Types whose objects may come into existence by writing their bytes, so
+// spare capacity can be filled without constructing elements first
+template<typename T>
+concept overwritable =
+    std::is_trivially_default_constructible_v<T> &&
+    std::is_trivially_copyable_v<T>;
+
+// Smallest unsigned type able to hold offsets up to N
+template<std::size_t N>
+using offset_t = std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+      std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::size_t>>;
+
+template<typename T, typename Layout>
+constexpr std::size_t layout_alignment()
+{
+    return std::max(Layout::alignment, alignof(T));
+}
 
-        iterator operator+(difference_type n)
-        {
-            iterator tmp = *this;
+template<typename T, std::size_t S, SizePosition P>
+struct vector_storage;
 
-            tmp += n;
-            return tmp;
-        }
+template<typename T, std::size_t S>
+struct vector_storage<T, S, SizePosition::front> {
+    std::size_t _size = 0;
+    alignas(T) uint8_t _underling[sizeof(T) * S];
+};
 
-        iterator& operator-=(difference_type n)
-        {
-            if (n < 0) {
-                return (*this) += -n;
-            }
+template<typename T, std::size_t S>
+struct vector_storage<T, S, SizePosition::back> {
+    alignas(T) uint8_t _underling[sizeof(T) * S];
+    std::size_t _size = 0;
+};
 
-            difference_type amnt = std::min(_index,
-                    static_cast<std::size_t>(n));
+// Move n live objects from src to dst, leaving src uninitialized. The ranges
+// may overlap.
+template<typename T>
+void relocate(T *dst, T *src, std::size_t n)
+{
+    if (0 == n || dst == src) {
+        return;
+    }
 
-            _index -= amnt;
-            return *this;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::memmove(static_cast<void *>(dst),
+                     static_cast<const void *>(src),
+                     n * sizeof(T));
+    } else if (dst < src) {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::construct_at(&dst[i], std::move(src[i]));
+            std::destroy_at(&src[i]);
         }
-
-        iterator operator-(difference_type n)
-        {
-            iterator tmp = *this;
-
-            tmp -= n;
-            return tmp;
+    } else {
+        for (std::size_t i = n; i > 0; --i) {
+            std::construct_at(&dst[i - 1], std::move(src[i - 1]));
+            std::destroy_at(&src[i - 1]);
         }
+    }
+}
 
-        reference operator[](difference_type n)
-        {
-            return (*_parent)[_index + n];
-        }
+} // namespace detail
 
-        bool operator<(const iterator &it) const
-        {
-            return _index < it._index;
-        }
+} // namespace staticvec
 
-        bool operator>(const iterator &it) const
-        {
-            return _index > it._index;
-        }
+template<typename T, std::size_t S,
+         typename Layout = staticvec::DefaultLayout>
+class alignas(staticvec::detail::layout_alignment<T, Layout>()) StaticVector
+    : private staticvec::detail::vector_storage<T, S, Layout::size_position>
+{
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    template<typename U>
+    class basic_iterator {
+    public:
+        using iterator_concept   = std::contiguous_iterator_tag;
+        using iterator_category  = std::random_access_iterator_tag;
+        using difference_type    = std::ptrdiff_t;
+        using value_type         = T;
+        using pointer            = U*;
+        using reference          = U&;
 
-        bool operator>=(const iterator &it) const
+        basic_iterator()
+            : _parent(nullptr), _index(0)
         {
-            return _index >= it._index;
-        }
 
-        bool operator<=(const iterator &it) const
-        {
-            return _index <= it._index;
         }
 
-    private:
-        friend StaticVector<T, S>;
+        basic_iterator(const basic_iterator &it) = default;
+        basic_iterator(basic_iterator &&it) = default;
 
-        iterator(StaticVector<T, S> *parent, difference_type start = 0)
-            : _parent(parent), _index(start)
+        template<typename V>
+            requires (std::is_const_v<U> && !std::is_const_v<V>)
+        basic_iterator(const basic_iterator<V> &it)
+            : _parent(it._parent), _index(it._index)
         {
 
         }
 
-        StaticVector<T, S> *_parent;
-        size_t _index;
-    };
-
-    class const_iterator {
-    public:
-        using interator_category = std::contiguous_iterator_tag;
-        using difference_type    = std::ptrdiff_t;
-        using value_type         = const T;
-        using pointer            = const T*;
-        using reference          = const T&;
+        basic_iterator& operator=(const basic_iterator &it) = default;
+        basic_iterator& operator=(basic_iterator &&it) = default;
 
-        const_iterator(const const_iterator &it) = default;
-        const_iterator(const_iterator &&it) = default;
-
-        const_iterator(const iterator &it)
-            : _parent(it._parent), _index(it._index)
+        friend bool operator ==(const basic_iterator &a, const basic_iterator &b)
         {
-
+            return (a._parent == b._parent) &&
+                (a._index == b._index);
         }
 
-        const_iterator& operator=(const const_iterator &it) = default;
-        const_iterator& operator=(const_iterator &&it) = default;
-
-        bool operator ==(const const_iterator &it) const
+        // Ordered by parent first, so only equal iterators compare equal
+        friend std::strong_ordering operator <=>(const basic_iterator &a,
+                                                 const basic_iterator &b)
         {
-            return (_parent == it._parent) &&
-                (_index == it._index);
+            if (auto c = std::compare_three_way()(a._parent, b._parent); c != 0) {
+                return c;
+            }
+
+            return a._index <=> b._index;
         }
 
-        bool operator !=(const const_iterator &it) const
+        reference operator*() const
         {
-            return (_parent != it._parent) ||
-                (_index != it._index);
+            return (*_parent)[_index];
         }
 
-        reference operator*()
+        pointer operator->() const
         {
-            return _parent->at(_index);
+            return _parent->data() + _index;
         }
 
-        pointer operator->()
+        reference operator[](difference_type n) const
         {
-            return &_parent->at(_index);
+            return (*_parent)[_index + n];
         }
 
-        const_iterator& operator++()
+        basic_iterator& operator++()
         {
             if (_index < _parent->size()) {
                 _index++;
@@ -223,18 +333,15 @@ public:
             return *this;
         }
 
-        const_iterator operator++(int)
+        basic_iterator operator++(int)
         {
-            const_iterator tmp = *this;
-
-            if (_index < _parent->size()) {
-                _index++;
-            }
+            basic_iterator tmp = *this;
 
+            ++(*this);
             return tmp;
         }
 
-        const_iterator& operator--()
+        basic_iterator& operator--()
         {
             if (_index > 0) {
                 _index--;
@@ -243,188 +350,246 @@ public:
             return *this;
         }
 
-        const_iterator& operator--(int)
+        basic_iterator operator--(int)
         {
-            const_iterator tmp = *this;
-
-            if (_index > 0) {
-                _index--;
-            }
+            basic_iterator tmp = *this;
 
+            --(*this);
             return tmp;
         }
 
-        const_iterator& operator+=(difference_type n)
+        basic_iterator& operator+=(difference_type n)
         {
             if (n < 0) {
                 return (*this) -= -n;
             }
 
-            difference_type amnt = std::min(
-                    _parent->size() - _index,
-                    static_cast<std::size_t>(n));
-
-            _index += amnt;
+            _index += std::min(_parent->size() - _index,
+                               static_cast<std::size_t>(n));
             return *this;
         }
 
-        const_iterator operator+(difference_type n)
-        {
-            const_iterator tmp = *this;
-
-            tmp += n;
-            return tmp;
-        }
-
-        const_iterator& operator-=(difference_type n)
+        basic_iterator& operator-=(difference_type n)
         {
             if (n < 0) {
                 return (*this) += -n;
             }
 
-            difference_type amnt = std::min(_index,
-                    static_cast<std::size_t>(n));
-
-            _index -= amnt;
+            _index -= std::min(_index, static_cast<std::size_t>(n));
             return *this;
         }
 
-        const_iterator operator-(difference_type n)
+        friend basic_iterator operator+(basic_iterator it, difference_type n)
         {
-            const_iterator tmp = *this;
-
-            tmp -= n;
-            return tmp;
+            return it += n;
         }
 
-        reference operator[](difference_type n)
+        friend basic_iterator operator+(difference_type n, basic_iterator it)
         {
-            return (*_parent)[_index + n];
+            return it += n;
         }
 
-        bool operator<(const const_iterator &it) const
+        friend basic_iterator operator-(basic_iterator it, difference_type n)
         {
-            return _index < it._index;
+            return it -= n;
         }
 
-        bool operator>(const const_iterator &it) const
+        friend difference_type operator-(const basic_iterator &a,
+                                         const basic_iterator &b)
         {
-            return _index > it._index;
+            return static_cast<difference_type>(a._index) -
+                static_cast<difference_type>(b._index);
         }
 
-        bool operator>=(const const_iterator &it) const
-        {
-            return _index >= it._index;
-        }
+    private:
+        friend StaticVector<T, S, Layout>;
 
-        bool operator<=(const const_iterator &it) const
-        {
-            return _index <= it._index;
-        }
+        template<typename>
+        friend class basic_iterator;
 
-    private:
-        friend StaticVector<T, S>;
+        using parent_type = std::conditional_t<std::is_const_v<U>,
+              const StaticVector<T, S, Layout>, StaticVector<T, S, Layout>>;
 
-        const_iterator(const StaticVector<T, S> *parent, difference_type start = 0)
+        basic_iterator(parent_type *parent, std::size_t start = 0)
             : _parent(parent), _index(start)
         {
 
         }
 
-        const StaticVector<T, S> *_parent;
-        size_t _index;
+        parent_type *_parent;
+        std::size_t _index;
     };
 
+    using iterator               = basic_iterator<T>;
+    using const_iterator         = basic_iterator<const T>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
     StaticVector()
-        : _underling(), _buffer(reinterpret_cast<T *>(_underling)), _size(0)
     {
 
     }
 
-    StaticVector(const StaticVector<T, S> &other)
-        : StaticVector()
+    StaticVector(const StaticVector<T, S, Layout> &other)
     {
-        *this = other;
+        std::uninitialized_copy_n(other.data(), other._size, data());
+        _size = other._size;
     }
 
-    StaticVector(StaticVector<T, S> &&other)
-        : StaticVector()
+    StaticVector(StaticVector<T, S, Layout> &&other)
     {
-        *this = std::forward<StaticVector<T, S>>(other);
+        if constexpr (staticvec::is_trivially_relocatable_v<T>) {
+            staticvec::detail::relocate(data(), other.data(), other._size);
+            _size = other._size;
+            other._size = 0;
+        } else {
+            std::uninitialized_move_n(other.data(), other._size, data());
+            _size = other._size;
+            other.clear();
+        }
     }
 
     StaticVector(const T &val, std::size_t s = S)
-        : StaticVector()
     {
-        for (std::size_t i = 0; i < s; ++i) {
-            push_back(val);
-        }
+        s = fit(s, "StaticVector fill past capacity");
+        std::uninitialized_fill_n(data(), s, val);
+        _size = s;
+    }
+
+    template<std::input_iterator InputIT>
+    StaticVector(InputIT first, InputIT last)
+    {
+        assign(first, last);
     }
 
     StaticVector(const std::initializer_list<T> &l)
-        : StaticVector()
+        : StaticVector(l.begin(), l.end())
     {
-        for (auto &i : l) {
-            push_back(i);
-        }
+
     }
 
-    ~StaticVector()
+    // Sources whose size is part of their type are checked at compile time
+    // and copied without any capacity checks; larger ones do not take part
+    // in overload resolution. A string literal keeps its terminating NUL;
+    // StaticString is the type for text.
+    template<std::size_t N>
+        requires (N <= S)
+    StaticVector(const T (&arr)[N])
     {
-        clear();
+        std::uninitialized_copy_n(arr, N, data());
+        _size = N;
     }
 
-    StaticVector<T, S>& operator=(const std::initializer_list<T> &l)
+    template<std::size_t N>
+        requires (N <= S)
+    StaticVector(const std::array<T, N> &arr)
     {
-        clear();
+        std::uninitialized_copy_n(arr.data(), N, data());
+        _size = N;
+    }
+
+    template<std::size_t N>
+        requires (N <= S)
+    StaticVector(std::array<T, N> &&arr)
+    {
+        std::uninitialized_move_n(arr.data(), N, data());
+        _size = N;
+    }
 
-        for (const auto &i : l) {
-            push_back(i);
+    template<std::size_t R, typename L>
+        requires (R <= S)
+    StaticVector(const StaticVector<T, R, L> &other)
+    {
+        std::uninitialized_copy_n(other.data(), other._size, data());
+        _size = other._size;
+    }
+
+    template<std::size_t R, typename L>
+        requires (R <= S)
+    StaticVector(StaticVector<T, R, L> &&other)
+    {
+        if constexpr (staticvec::is_trivially_relocatable_v<T>) {
+            staticvec::detail::relocate(data(), other.data(), other._size);
+            _size = other._size;
+            other._size = 0;
+        } else {
+            std::uninitialized_move_n(other.data(), other._size, data());
+            _size = other._size;
+            other.clear();
         }
+    }
 
-        return *this;
+    template<staticvec::detail::container_compatible_range<T> R>
+    StaticVector(staticvec::from_range_t, R&& rg)
+    {
+        append_range(std::forward<R>(rg));
     }
 
-    StaticVector<T, S>& operator=(const StaticVector<T, S> &rhs)
+    ~StaticVector()
     {
         clear();
+    }
+
+    StaticVector<T, S, Layout>& operator=(const std::initializer_list<T> &l)
+    {
+        assign(l.begin(), l.end());
+        return *this;
+    }
 
-        for (auto it = rhs.cbegin(); it != rhs.cend(); ++it) {
-            push_back(*it);
+    StaticVector<T, S, Layout>& operator=(const StaticVector<T, S, Layout> &rhs)
+    {
+        if (this != &rhs) {
+            assign_n(rhs.data(), rhs._size);
         }
 
         return *this;
     }
 
-    StaticVector<T, S>& operator=(StaticVector<T, S> &&rhs)
+    StaticVector<T, S, Layout>& operator=(StaticVector<T, S, Layout> &&rhs)
     {
-        clear();
+        if (this == &rhs) {
+            return *this;
+        }
 
-        for (std::size_t i = 0; i < rhs.size(); ++i) {
-            push_back(std::move(rhs[i]));
+        if constexpr (staticvec::is_trivially_relocatable_v<T>) {
+            clear();
+            staticvec::detail::relocate(data(), rhs.data(), rhs._size);
+            _size = rhs._size;
+            rhs._size = 0;
+        } else {
+            assign_n(std::make_move_iterator(rhs.data()), rhs._size);
+            rhs.clear();
         }
 
-        rhs.clear();
         return *this;
     }
 
     void assign(std::size_t count, const T& value)
     {
-        clear();
+        count = fit(count, "assign past StaticVector size");
 
-        for (std::size_t i = 0; i < count; ++i) {
-            push_back(value);
+        if (count <= _size) {
+            std::fill_n(data(), count, value);
+            truncate(count);
+        } else {
+            std::fill_n(data(), _size, value);
+            std::uninitialized_fill_n(data() + _size, count - _size, value);
+            _size = count;
         }
     }
 
-    template<typename InputIT>
-    void assign(InputIT first, InputIT back)
+    template<std::input_iterator InputIT>
+    void assign(InputIT first, InputIT last)
     {
-        clear();
+        if constexpr (std::forward_iterator<InputIT>) {
+            assign_n(first, std::distance(first, last));
+        } else {
+            clear();
 
-        while (first != back) {
-            push_back(*first);
-            ++first;
+            while (first != last) {
+                emplace_back(*first);
+                ++first;
+            }
         }
     }
 
@@ -433,6 +598,13 @@ public:
         (*this) = ilist;
     }
 
+    template<staticvec::detail::container_compatible_range<T> R>
+    void assign_range(R&& rg)
+    {
+        clear();
+        append_range(std::forward<R>(rg));
+    }
+
     std::size_t size() const
     {
         return _size;
@@ -455,30 +627,34 @@ public:
 
     T& operator[](std::size_t i)
     {
-        return _buffer[i];
+        if constexpr (staticvec::detail::check_enabled(STATICVEC_INDEX_CHECK)) {
+            if (i >= _size) [[unlikely]] {
+                staticvec::detail::out_of_range("StaticVector::operator[]");
+            }
+        }
+
+        return data()[i];
     }
 
     const T& operator[](std::size_t i) const
     {
-        return _buffer[i];
+        return const_cast<StaticVector<T, S, Layout> *>(this)->operator[](i);
     }
 
     T& at(std::size_t i)
     {
-        if (empty() || i >= _size) {
-#ifdef __cpp_exceptions
-            throw std::out_of_range("StaticVector::at");
-#else
-            abort();
-#endif
+        if constexpr (staticvec::detail::check_enabled(STATICVEC_AT_CHECK)) {
+            if (i >= _size) [[unlikely]] {
+                staticvec::detail::out_of_range("StaticVector::at");
+            }
         }
 
-        return _buffer[i];
+        return data()[i];
     }
 
     const T& at(std::size_t i) const
     {
-        return const_cast<StaticVector<T, S> *>(this)->at(i);
+        return const_cast<StaticVector<T, S, Layout> *>(this)->at(i);
     }
 
     T& front()
@@ -488,7 +664,7 @@ public:
 
     const T& front() const
     {
-        return const_cast<StaticVector<T, S> *>(this)->front();
+        return const_cast<StaticVector<T, S, Layout> *>(this)->front();
     }
 
     T& back()
@@ -499,57 +675,53 @@ public:
 
     const T& back() const
     {
-        return const_cast<StaticVector<T, S> *>(this)->back();
+        return const_cast<StaticVector<T, S, Layout> *>(this)->back();
     }
 
     T* data()
     {
-        return _buffer;
+        return reinterpret_cast<T *>(_underling);
     }
 
     const T* data() const
     {
-        return _buffer;
+        return reinterpret_cast<const T *>(_underling);
+    }
+
+    // Uninitialized storage past the last element, e.g. to read() into.
+    // Written elements become part of the vector with commit().
+    std::span<T> spare_capacity() requires staticvec::detail::overwritable<T>
+    {
+        return std::span<T>(data() + _size, S - _size);
+    }
+
+    // Append the first n elements of spare_capacity() without initializing them
+    void commit(std::size_t n) requires staticvec::detail::overwritable<T>
+    {
+        _size += room_for(n, "commit past StaticVector size");
+    }
+
+    // Set size() to n. Elements past the old size are left uninitialized, which
+    // is only allowed for trivially default constructible and copyable T;
+    // shrinking just drops the trailing elements.
+    void resize_for_overwrite(std::size_t n) requires staticvec::detail::overwritable<T>
+    {
+        _size = fit(n, "resize_for_overwrite past StaticVector size");
     }
 
     void clear()
     {
-        for (unsigned int i = 0; i < _size; ++i) {
-            std::destroy_at(std::addressof(_buffer[i]));
-        }
-        _size = 0;
+        truncate(0);
     }
 
     iterator insert(const_iterator pos, const T& val)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("insert past StaticVector size");
-#else
-            abort();
-#endif
-        }
-
-        shift_back(pos._index);
-        std::construct_at(&_buffer[pos._index], val);
-        _size++;
-        return iterator(this, pos._index);
+        return emplace(pos, val);
     }
 
     iterator insert(const_iterator pos, T&& val)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("insert past StaticVector size");
-#else
-            abort();
-#endif
-        }
-
-        shift_back(pos._index);
-        std::construct_at(&_buffer[pos._index], std::forward<T>(val));
-        _size++;
-        return iterator(this, pos._index);
+        return emplace(pos, std::move(val));
     }
 
     iterator insert(const_iterator pos, std::size_t count, const T& value)
@@ -558,71 +730,83 @@ public:
             return iterator(this, pos._index);
         }
 
-        if (_size + count > S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("insert past StaticVector size");
-#else
-            abort();
-#endif
-        }
+        count = room_for(count, "insert past StaticVector size");
 
         shift_back(pos._index, count);
-        for (std::size_t i = 0; i < count; ++i) {
-            std::construct_at(&_buffer[pos._index + i], value);
-        }
+        std::uninitialized_fill_n(data() + pos._index, count, value);
 
         _size += count;
         return iterator(this, pos._index);
     }
 
-    template<typename IT>
+    template<std::input_iterator IT>
     iterator insert(const_iterator pos, IT first, IT last)
     {
-        std::size_t count = std::distance(first, last);
+        return insert_range(pos, std::ranges::subrange(first, last));
+    }
 
-        if (0 == count) {
-            return iterator(this, pos._index);
-        }
+    iterator insert(const_iterator pos, std::initializer_list<T> l)
+    {
+        return insert(pos, l.begin(), l.end());
+    }
 
-        if (_size + count > S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("insert past StaticVector size");
-#else
-            abort();
-#endif
-        }
+    template<staticvec::detail::container_compatible_range<T> R>
+    iterator insert_range(const_iterator pos, R&& rg)
+    {
+        std::size_t index = pos._index;
 
-        shift_back(pos._index, count);
-        std::size_t index = 0;
-        while (first != last) {
-            std::construct_at(&_buffer[pos._index + index], *first);
-            first++;
-            index++;
-        }
+        if constexpr (std::ranges::forward_range<R> ||
+                      std::ranges::sized_range<R>) {
+            std::size_t count = room_for(std::ranges::distance(rg),
+                                         "insert past StaticVector size");
+            shift_back(index, count);
+            std::uninitialized_copy_n(std::ranges::begin(rg), count,
+                                      data() + index);
 
-        _size += count;
+            _size += count;
+        } else {
+            // Single pass ranges are appended and rotated into place
+            std::size_t old_size = _size;
 
-        return iterator(this, pos._index);
+            for (auto &&val : rg) {
+                if (0 == room_for(1, "insert past StaticVector size")) {
+                    break;
+                }
+
+                std::construct_at(data() + _size,
+                                  std::forward<decltype(val)>(val));
+                _size++;
+            }
+
+            std::rotate(data() + index, data() + old_size, data() + _size);
+        }
+
+        return iterator(this, index);
     }
 
-    iterator insert(const_iterator pos, std::initializer_list<T> l)
+    template<staticvec::detail::container_compatible_range<T> R>
+    void append_range(R&& rg)
     {
-        return insert(pos, l.begin(), l.end());
+        insert_range(cend(), std::forward<R>(rg));
     }
 
     template<typename ...Args>
     iterator emplace(const_iterator pos, Args&& ...args)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("insert past StaticVector size");
-#else
-            abort();
-#endif
+        if (0 == room_for(1, "insert past StaticVector size")) {
+            return iterator(this, _size);
+        }
+
+        if (pos._index == _size) {
+            std::construct_at(data() + _size, std::forward<Args>(args)...);
+        } else {
+            // The arguments may refer to elements about to be shifted
+            T tmp(std::forward<Args>(args)...);
+
+            shift_back(pos._index);
+            std::construct_at(data() + pos._index, std::move(tmp));
         }
 
-        shift_back(pos._index);
-        std::construct_at(&_buffer[pos._index], std::forward<Args>(args)...);
         _size++;
         return iterator(this, pos._index);
     }
@@ -642,65 +826,68 @@ public:
             return this->end();
         }
 
-        std::size_t dist = std::min(last._index, _size) - first._index;
-        std::size_t dst = first._index;
-        std::size_t src = dst + dist;
+        std::size_t end = std::min(last._index, _size);
 
-        while (dst < _size) {
-            _buffer[dst] = std::move(_buffer[src]);
+        std::destroy(data() + first._index, data() + end);
+        staticvec::detail::relocate(data() + first._index, data() + end,
+                                    _size - end);
 
-            std::destroy_at(&_buffer[src]);
+        _size -= end - first._index;
+        return iterator(this, first._index);
+    }
 
-            ++src;
-            ++dst;
-        }
+    T& push_back(const T &t)
+    {
+        return emplace_back(t);
+    }
 
-        _size -= dist;
-        return iterator(this, first._index);
+    T& push_back(T &&t)
+    {
+        return emplace_back(std::move(t));
     }
 
-    void push_back(const T &t)
+    // With the SATURATE policy a full vector drops the new element and
+    // returns the last one, which is left unchanged
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("push_back past StaticVector size");
-#else
-            abort();
-#endif
+        if (0 == room_for(1, "push_back past StaticVector size")) {
+            if constexpr (S == 0) {
+                // Nothing to refer to
+                std::abort();
+            }
+
+            return data()[_size - 1];
         }
 
-        std::construct_at(&_buffer[_size], t);
+        T *res = std::construct_at(data() + _size, std::forward<Args>(args)...);
         _size++;
+        return *res;
     }
 
-    void push_back(T &&t)
+#ifdef __cpp_lib_expected
+    std::expected<T *, staticvec::errc> try_push_back(const T &t)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("push_back past StaticVector size");
-#else
-            abort();
-#endif
-        }
+        return try_emplace_back(t);
+    }
 
-        std::construct_at(&_buffer[_size], std::forward<T>(t));
-        _size++;
+    std::expected<T *, staticvec::errc> try_push_back(T &&t)
+    {
+        return try_emplace_back(std::move(t));
     }
 
     template<typename ...Args>
-    void emplace_back(Args ...args)
+    std::expected<T *, staticvec::errc> try_emplace_back(Args&& ...args)
     {
-        if (_size >= S) {
-#ifdef __cpp_exceptions
-            throw std::length_error("push_back past StaticVector size");
-#else
-            abort();
-#endif
+        if (_size >= S) [[unlikely]] {
+            return std::unexpected(staticvec::errc::capacity_exceeded);
         }
 
-        std::construct_at(&_buffer[_size], std::move(args)...);
+        T *res = std::construct_at(data() + _size, std::forward<Args>(args)...);
         _size++;
+        return res;
     }
+#endif
 
     void pop_back()
     {
@@ -708,7 +895,7 @@ public:
             return;
         }
 
-        std::destroy_at(&_buffer[_size-1]);
+        std::destroy_at(data() + _size - 1);
         _size--;
     }
 
@@ -722,6 +909,16 @@ public:
         return iterator(this, size());
     }
 
+    const_iterator begin() const
+    {
+        return const_iterator(this);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
     const_iterator cbegin() const
     {
         return const_iterator(this);
@@ -732,6 +929,36 @@ public:
         return const_iterator(this, size());
     }
 
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const
+    {
+        return rend();
+    }
+
     iterator find(const T& val)
     {
         return find(begin(), val);
@@ -752,61 +979,125 @@ public:
         return this->end();
     }
 
-    template<std::size_t R=S>
-    StaticVector<T, R> splitoff(const_iterator at)
+    void swap(StaticVector<T, S, Layout> &other)
     {
-        StaticVector<T, R> res;
+        if (this == &other) {
+            return;
+        }
 
-        for (std::size_t i = 0; i < R; ++i) {
-            if (at == end()) {
-                break;
-            }
+        StaticVector<T, S, Layout> &longer = _size >= other._size ? *this : other;
+        StaticVector<T, S, Layout> &shorter = _size >= other._size ? other : *this;
+        std::size_t common = shorter._size;
 
-            res[i] = *at;
-            ++at;
+        if constexpr (staticvec::is_trivially_relocatable_v<T>) {
+            std::swap_ranges(reinterpret_cast<uint8_t *>(data()),
+                             reinterpret_cast<uint8_t *>(data() + common),
+                             reinterpret_cast<uint8_t *>(other.data()));
+        } else {
+            std::swap_ranges(data(), data() + common, other.data());
         }
 
+        staticvec::detail::relocate(shorter.data() + common,
+                                    longer.data() + common,
+                                    longer._size - common);
+        std::swap(_size, other._size);
+    }
+
+    // Move the elements from at onwards into a new vector, leaving this one
+    // with the elements before at
+    template<std::size_t R=S>
+    StaticVector<T, R, Layout> splitoff(const_iterator at)
+    {
+        StaticVector<T, R, Layout> res;
+        std::size_t count = res.fit(_size - at._index,
+                                    "splitoff past StaticVector size");
+
+        staticvec::detail::relocate(res.data(), data() + at._index, count);
+        res._size = count;
+
+        std::destroy(data() + at._index + count, data() + _size);
+        _size = at._index;
+
         return res;
     }
 
 private:
-    uint8_t _underling[sizeof(T) * S];
-    T* _buffer;
-    std::size_t _size;
+    template<typename, std::size_t, typename>
+    friend class StaticVector;
 
-    void shift_back(std::size_t at, std::size_t amnt = 1)
+    using staticvec::detail::vector_storage<T, S, Layout::size_position>::_underling;
+    using staticvec::detail::vector_storage<T, S, Layout::size_position>::_size;
+
+    std::size_t fit(std::size_t count, const char *what) const
     {
-        if (0 == _size) {
-            return;
+        if (count <= S) [[likely]] {
+            return count;
         }
 
-        std::size_t new_size = _size + amnt;
-        std::size_t shift_size = new_size - at;
+        return staticvec::detail::overflow(S, what);
+    }
+
+    std::size_t room_for(std::size_t count, const char *what) const
+    {
+        if (count <= S - _size) [[likely]] {
+            return count;
+        }
 
-        std::size_t src = _size - 1;
-        std::size_t dst = new_size - 1;
+        return staticvec::detail::overflow(S - _size, what);
+    }
 
-        while (src >= at) {
-            std::construct_at(&_buffer[dst],
-                              std::move(_buffer[src]));
+    // Replace the contents with count elements read from first, reusing the
+    // live elements by assignment
+    template<typename IT>
+    void assign_n(IT first, std::size_t count)
+    {
+        count = fit(count, "assign past StaticVector size");
+        std::size_t common = std::min(count, _size);
 
-            std::destroy_at(&_buffer[src]);
+        for (std::size_t i = 0; i < common; ++i, ++first) {
+            data()[i] = *first;
+        }
 
-            // If src is 0 then subtracting will underflow the unsigned int
-            if (src == 0) {
-                break;
-            }
+        if (count <= _size) {
+            truncate(count);
+        } else {
+            std::uninitialized_copy_n(first, count - common, data() + common);
+            _size = count;
+        }
+    }
 
-            dst--;
-            src--;
+    void truncate(std::size_t n)
+    {
+        if (n < _size) {
+            std::destroy(data() + n, data() + _size);
+            _size = n;
         }
     }
 
+    void shift_back(std::size_t at, std::size_t amnt = 1)
+    {
+        if (at >= _size) {
+            return;
+        }
 
+        staticvec::detail::relocate(data() + at + amnt, data() + at,
+                                    _size - at);
+    }
 };
 
-template<typename T, std::size_t S>
-bool operator ==(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+void swap(StaticVector<T, S, L> &a, StaticVector<T, S, L> &b)
+{
+    a.swap(b);
+}
+
+// Without a self-pointer a StaticVector moves like its elements
+template<typename T, std::size_t S, typename L>
+struct staticvec::is_trivially_relocatable<StaticVector<T, S, L>>
+    : staticvec::is_trivially_relocatable<T> {};
+
+template<typename T, std::size_t S, typename L>
+bool operator ==(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     if (a.size() != b.size()) {
         return false;
@@ -821,8 +1112,8 @@ bool operator ==(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return true;
 }
 
-template<typename T, std::size_t S>
-bool operator !=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+bool operator !=(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     if (a.size() != b.size()) {
         return true;
@@ -837,8 +1128,8 @@ bool operator !=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return false;
 }
 
-template<typename T, std::size_t S>
-bool operator <(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+bool operator <(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     std::size_t max = std::min(a.size(), b.size());
 
@@ -851,8 +1142,8 @@ bool operator <(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return b.size() >= a.size();
 }
 
-template<typename T, std::size_t S>
-bool operator <=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+bool operator <=(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     std::size_t max = std::min(a.size(), b.size());
 
@@ -865,8 +1156,8 @@ bool operator <=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return a.size() <= b.size();
 }
 
-template<typename T, std::size_t S>
-bool operator >(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+bool operator >(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     std::size_t max = std::min(a.size(), b.size());
 
@@ -879,8 +1170,8 @@ bool operator >(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return b.size() < a.size();
 }
 
-template<typename T, std::size_t S>
-bool operator >=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
+template<typename T, std::size_t S, typename L>
+bool operator >=(const StaticVector<T, S, L> &a, const StaticVector<T, S, L> &b)
 {
     std::size_t max = std::min(a.size(), b.size());
 
@@ -893,10 +1184,305 @@ bool operator >=(const StaticVector<T, S> &a, const StaticVector<T, S> &b)
     return a.size() >= b.size();
 }
 
+namespace staticvec::detail {
+
+// wyhash (final version 4, public domain) by Wang Yi
+
+inline void wymum(std::uint64_t *a, std::uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = *a;
+    r *= *b;
+    *a = static_cast<std::uint64_t>(r);
+    *b = static_cast<std::uint64_t>(r >> 64);
+#else
+    std::uint64_t ha = *a >> 32, hb = *b >> 32;
+    std::uint64_t la = static_cast<std::uint32_t>(*a);
+    std::uint64_t lb = static_cast<std::uint32_t>(*b);
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    std::uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t wymix(std::uint64_t a, std::uint64_t b)
+{
+    wymum(&a, &b);
+    return a ^ b;
+}
+
+inline std::uint64_t wyr8(const std::uint8_t *p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t wyr4(const std::uint8_t *p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline std::uint64_t wyr3(const std::uint8_t *p, std::size_t k)
+{
+    return (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[k >> 1]) << 8) |
+        p[k - 1];
+}
+
+inline constexpr std::uint64_t wysecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+inline std::uint64_t hash_bytes(const void *key, std::size_t len,
+                                std::uint64_t seed = 0)
+{
+    const auto *p = static_cast<const std::uint8_t *>(key);
+    std::uint64_t a, b;
+
+    seed ^= wymix(seed ^ wysecret[0], wysecret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+            b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = wyr3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = len;
+
+        if (i > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+
+            do {
+                seed = wymix(wyr8(p) ^ wysecret[1], wyr8(p + 8) ^ seed);
+                see1 = wymix(wyr8(p + 16) ^ wysecret[2], wyr8(p + 24) ^ see1);
+                see2 = wymix(wyr8(p + 32) ^ wysecret[3], wyr8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = wymix(wyr8(p) ^ wysecret[1], wyr8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = wyr8(p + i - 16);
+        b = wyr8(p + i - 8);
+    }
+
+    a ^= wysecret[1];
+    b ^= seed;
+    wymum(&a, &b);
+    return wymix(a ^ wysecret[0] ^ len, b ^ wysecret[1]);
+}
+
+} // namespace staticvec::detail
+
+// Bytewise hashable elements are hashed as a single byte span, others by
+// combining their std::hash values.
+template<typename T, std::size_t S, typename L>
+    requires (staticvec::is_bytewise_hashable_v<T> ||
+              requires(const T &t) { std::hash<T>()(t); })
+struct std::hash<StaticVector<T, S, L>> {
+    std::size_t operator()(const StaticVector<T, S, L> &vec) const noexcept
+    {
+        if constexpr (staticvec::is_bytewise_hashable_v<T>) {
+            return staticvec::detail::hash_bytes(vec.data(),
+                                                 vec.size() * sizeof(T));
+        } else {
+            std::uint64_t h = staticvec::detail::wysecret[0] ^ vec.size();
+
+            for (const T &t : vec) {
+                h = staticvec::detail::wymix(h ^ std::hash<T>()(t),
+                                             staticvec::detail::wysecret[1]);
+            }
+
+            return h;
+        }
+    }
+};
+
+namespace staticvec::detail {
+
+// Element types written with std::to_chars instead of the stream or
+// formatter machinery
+template<typename T>
+concept to_chars_integral =
+    std::integral<T> &&
+    !std::same_as<T, bool> &&
+    !std::same_as<T, char> &&
+    !std::same_as<T, signed char> &&
+    !std::same_as<T, unsigned char> &&
+    !std::same_as<T, wchar_t> &&
+    !std::same_as<T, char8_t> &&
+    !std::same_as<T, char16_t> &&
+    !std::same_as<T, char32_t>;
+
+// Append vec to out as {a, b, c}, formatting through a stack buffer
+template<typename T, std::size_t S, typename L, typename Write>
+void write_braced(const StaticVector<T, S, L> &vec, Write &&write)
+{
+    // Room for any integer, a separator and the closing brace
+    constexpr std::size_t reserve = 48;
+    char buf[512];
+    std::size_t len = 0;
+
+    buf[len++] = '{';
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        if (sizeof(buf) - len < reserve) {
+            write(buf, len);
+            len = 0;
+        }
+
+        if (i != 0) {
+            buf[len++] = ',';
+            buf[len++] = ' ';
+        }
+
+        if constexpr (std::same_as<T, char>) {
+            buf[len++] = vec[i];
+        } else if constexpr (std::same_as<T, std::byte>) {
+            len = std::to_chars(buf + len, buf + sizeof(buf),
+                                std::to_integer<unsigned>(vec[i])).ptr - buf;
+        } else {
+            len = std::to_chars(buf + len, buf + sizeof(buf), vec[i]).ptr - buf;
+        }
+    }
+
+    buf[len++] = '}';
+    write(buf, len);
+}
+
+} // namespace staticvec::detail
+
+#ifdef __cpp_lib_format
+// Formats as [a, b, c] like the standard range formatter. Supported specs:
+// "n" drops the brackets, "s" writes a char vector as a string and anything
+// after a ':' is passed to the element formatter, e.g. "{::#x}".
+template<typename T, std::size_t S, typename L>
+struct std::formatter<StaticVector<T, S, L>, char> {
+    constexpr auto parse(std::format_parse_context &ctx)
+    {
+        auto it = ctx.begin();
+
+        if (it != ctx.end() && *it == 'n') {
+            _bare = true;
+            ++it;
+        }
+
+        if constexpr (std::same_as<T, char>) {
+            if (it != ctx.end() && *it == 's') {
+                _string = true;
+                ++it;
+            }
+        }
+
+        if (it != ctx.end() && *it == ':') {
+            ctx.advance_to(++it);
+            it = _element.parse(ctx);
+            _element_spec = true;
+        }
+
+        if (it != ctx.end() && *it != '}') {
+            throw std::format_error("invalid StaticVector format spec");
+        }
+
+        return it;
+    }
+
+    template<typename FormatContext>
+    auto format(const StaticVector<T, S, L> &vec, FormatContext &ctx) const
+    {
+        auto out = ctx.out();
+
+        if constexpr (std::same_as<T, char>) {
+            if (_string) {
+                return std::ranges::copy(vec.data(), vec.data() + vec.size(),
+                                         out).out;
+            }
+        }
+
+        if (!_bare) {
+            *out++ = '[';
+        }
+
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            if (i != 0) {
+                *out++ = ',';
+                *out++ = ' ';
+            }
+
+            if constexpr (staticvec::detail::to_chars_integral<T> ||
+                          std::floating_point<T>) {
+                if (!_element_spec) {
+                    char buf[64];
+                    auto res = std::to_chars(buf, buf + sizeof(buf), vec[i]);
+
+                    out = std::ranges::copy(buf, res.ptr, out).out;
+                    continue;
+                }
+            }
+
+            ctx.advance_to(out);
+            out = _element.format(vec[i], ctx);
+        }
+
+        if (!_bare) {
+            *out++ = ']';
+        }
+
+        return out;
+    }
+
+private:
+    std::formatter<T, char> _element;
+    bool _bare = false;
+    bool _string = false;
+    bool _element_spec = false;
+};
+#endif
+
 #ifdef STATICVEC_SUPPORT_IOSTREAM
-template<typename T, std::size_t S>
-std::ostream& operator<<(std::ostream &os, const StaticVector<T, S> &vec)
+// Written as {a, b, c}, with bytes as numbers. Integer and char vectors are
+// formatted into a stack buffer and written in blocks unless the stream's
+// flags, width or locale ask for more than that.
+template<typename T, std::size_t S, typename L>
+std::ostream& operator<<(std::ostream &os, const StaticVector<T, S, L> &vec)
 {
+    if constexpr (staticvec::detail::to_chars_integral<T> ||
+                  std::same_as<T, char> || std::same_as<T, std::byte>) {
+        constexpr auto plain = std::ios_base::dec | std::ios_base::skipws;
+
+        if ((os.flags() & ~plain) == 0 && os.width() == 0 &&
+            os.getloc() == std::locale::classic()) {
+            std::ostream::sentry guard(os);
+
+            if (guard) {
+                staticvec::detail::write_braced(vec, [&os](const char *buf,
+                                                           std::size_t len) {
+                    os.write(buf, len);
+                });
+            }
+
+            return os;
+        }
+    }
+
     bool first = true;
     os << "{";
     for (auto it = vec.cbegin(); it != vec.cend(); ++it) {
@@ -906,7 +1492,11 @@ std::ostream& operator<<(std::ostream &os, const StaticVector<T, S> &vec)
             first = false;
         }
 
-        os << *it;
+        if constexpr (std::same_as<T, std::byte>) {
+            os << std::to_integer<unsigned>(*it);
+        } else {
+            os << *it;
+        }
     }
 
     os << "}";
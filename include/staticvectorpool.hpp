@@ -0,0 +1,208 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <staticvector.hpp>
+
+// N StaticVector<T, S> instances preallocated in one block and handed out
+// through RAII handles. Acquire and release pop and push an intrusive free
+// list in O(1); with Concurrent the list is a lock-free tagged stack that
+// any thread may use. Released vectors are cleared, which costs nothing for
+// trivially destructible T.
+template<typename T, std::size_t S, std::size_t N, bool Concurrent = false>
+class StaticVectorPool {
+    static_assert(N < UINT32_MAX, "pool too large for 32 bit slot indices");
+
+    static constexpr std::uint32_t nil = UINT32_MAX;
+
+    struct Slot {
+        StaticVector<T, S> vec;
+        std::atomic<std::uint32_t> next;
+    };
+
+public:
+    class Handle {
+    public:
+        Handle()
+            : _pool(nullptr), _slot(nil)
+        {
+
+        }
+
+        Handle(Handle &&other)
+            : _pool(std::exchange(other._pool, nullptr)),
+              _slot(std::exchange(other._slot, nil))
+        {
+
+        }
+
+        Handle& operator=(Handle &&other)
+        {
+            if (this != &other) {
+                reset();
+                _pool = std::exchange(other._pool, nullptr);
+                _slot = std::exchange(other._slot, nil);
+            }
+
+            return *this;
+        }
+
+        Handle(const Handle &) = delete;
+        Handle& operator=(const Handle &) = delete;
+
+        ~Handle()
+        {
+            reset();
+        }
+
+        explicit operator bool() const
+        {
+            return _pool != nullptr;
+        }
+
+        StaticVector<T, S>& operator*() const
+        {
+            return _pool->_slots[_slot].vec;
+        }
+
+        StaticVector<T, S>* operator->() const
+        {
+            return &_pool->_slots[_slot].vec;
+        }
+
+        // Return the vector to the pool early
+        void reset()
+        {
+            if (_pool) {
+                _pool->release(_slot);
+                _pool = nullptr;
+                _slot = nil;
+            }
+        }
+
+    private:
+        friend StaticVectorPool<T, S, N, Concurrent>;
+
+        Handle(StaticVectorPool<T, S, N, Concurrent> *pool, std::uint32_t slot)
+            : _pool(pool), _slot(slot)
+        {
+
+        }
+
+        StaticVectorPool<T, S, N, Concurrent> *_pool;
+        std::uint32_t _slot;
+    };
+
+    StaticVectorPool()
+        : _head(pack(N > 0 ? 0 : nil, 0))
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            _slots[i].next.store(i + 1 < N ? i + 1 : nil, std::memory_order_relaxed);
+        }
+    }
+
+    StaticVectorPool(const StaticVectorPool<T, S, N, Concurrent> &) = delete;
+    StaticVectorPool<T, S, N, Concurrent>& operator=(
+        const StaticVectorPool<T, S, N, Concurrent> &) = delete;
+
+    static constexpr std::size_t capacity()
+    {
+        return N;
+    }
+
+    // Take an empty vector, or an empty handle if the pool is exhausted
+    Handle try_acquire()
+    {
+        std::uint32_t slot = pop();
+
+        if (slot == nil) {
+            return Handle();
+        }
+
+        return Handle(this, slot);
+    }
+
+    // Take an empty vector, applying the overflow policy if the pool is
+    // exhausted. Under SATURATE the handle is empty.
+    Handle acquire()
+    {
+        Handle res = try_acquire();
+
+        if (!res) [[unlikely]] {
+            staticvec::detail::overflow(0, "StaticVectorPool exhausted");
+        }
+
+        return res;
+    }
+
+private:
+    Slot _slots[N];
+
+    // Index of the first free slot in the low half, ABA tag in the high half
+    std::conditional_t<Concurrent, std::atomic<std::uint64_t>, std::uint64_t> _head;
+
+    static std::uint64_t pack(std::uint32_t slot, std::uint32_t tag)
+    {
+        return (std::uint64_t(tag) << 32) | slot;
+    }
+
+    static std::uint32_t slot_of(std::uint64_t head)
+    {
+        return static_cast<std::uint32_t>(head);
+    }
+
+    static std::uint32_t tag_of(std::uint64_t head)
+    {
+        return static_cast<std::uint32_t>(head >> 32);
+    }
+
+    std::uint32_t pop()
+    {
+        if constexpr (Concurrent) {
+            std::uint64_t head = _head.load(std::memory_order_acquire);
+
+            for (;;) {
+                std::uint32_t slot = slot_of(head);
+                if (slot == nil) {
+                    return nil;
+                }
+
+                std::uint32_t next = _slots[slot].next.load(std::memory_order_relaxed);
+                if (_head.compare_exchange_weak(head, pack(next, tag_of(head) + 1),
+                                                std::memory_order_acquire,
+                                                std::memory_order_acquire)) {
+                    return slot;
+                }
+            }
+        } else {
+            std::uint32_t slot = slot_of(_head);
+
+            if (slot != nil) {
+                _head = pack(_slots[slot].next.load(std::memory_order_relaxed), 0);
+            }
+
+            return slot;
+        }
+    }
+
+    void release(std::uint32_t slot)
+    {
+        _slots[slot].vec.clear();
+
+        if constexpr (Concurrent) {
+            std::uint64_t head = _head.load(std::memory_order_relaxed);
+
+            do {
+                _slots[slot].next.store(slot_of(head), std::memory_order_relaxed);
+            } while (!_head.compare_exchange_weak(head, pack(slot, tag_of(head) + 1),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        } else {
+            _slots[slot].next.store(slot_of(_head), std::memory_order_relaxed);
+            _head = pack(slot, 0);
+        }
+    }
+};
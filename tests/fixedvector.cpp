@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <sstream>
+#include <string_view>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <fixedvector.hpp>
+
+TEST(FixedVector, create)
+{
+    alignas(std::max_align_t) std::byte buf[FixedVector<int>::storage_size(8)];
+    auto vec = FixedVector<int>::create(buf, sizeof(buf));
+
+    ASSERT_EQ(vec.capacity(), 8);
+    ASSERT_TRUE(vec.empty());
+
+    vec.assign({1, 2, 3});
+    vec.insert(vec.begin() + 1, 42);
+    vec.push_back(4);
+
+    auto view = FixedVector<int>::attach(buf);
+    ASSERT_EQ(view.size(), 5);
+    ASSERT_EQ(view[1], 42);
+    ASSERT_EQ(view.back(), 4);
+
+    view.erase(view.begin(), view.begin() + 2);
+    ASSERT_EQ(vec.size(), 3);
+    ASSERT_EQ(vec.front(), 2);
+
+    vec.insert(vec.end(), 5, 7);
+    ASSERT_EQ(vec.size(), 8);
+    ASSERT_THROW(vec.push_back(1), std::length_error);
+    ASSERT_THROW(vec.at(8), std::out_of_range);
+    ASSERT_THROW(FixedVector<long>::attach(buf), std::invalid_argument);
+}
+
+TEST(FixedVector, insert)
+{
+    alignas(std::max_align_t) std::byte buf[FixedVector<int>::storage_size(16)];
+    auto vec = FixedVector<int>::create(buf, sizeof(buf));
+
+    vec.assign(3, 5);
+    ASSERT_EQ(vec.size(), 3);
+    ASSERT_EQ(vec.back(), 5);
+
+    vec.insert(vec.begin(), 2, 7);
+    ASSERT_EQ(vec.size(), 5);
+    ASSERT_EQ(vec.front(), 7);
+
+    ASSERT_EQ(vec.push_back(9), 9);
+    int &last = vec.emplace_back(10);
+    ASSERT_EQ(&last, &vec.back());
+
+    // The argument refers to an element that is shifted
+    vec.emplace(vec.begin(), vec.back());
+    ASSERT_EQ(vec.front(), 10);
+    ASSERT_EQ(vec.back(), 10);
+
+    std::istringstream in("1 2 3");
+    vec.insert(vec.begin() + 1, std::istream_iterator<int>(in),
+               std::istream_iterator<int>());
+    ASSERT_EQ(vec.size(), 11);
+    ASSERT_EQ(vec[0], 10);
+    ASSERT_EQ(vec[1], 1);
+    ASSERT_EQ(vec[3], 3);
+    ASSERT_EQ(vec[4], 7);
+}
+
+TEST(FixedVector, ranges)
+{
+    alignas(std::max_align_t) std::byte buf_a[FixedVector<int>::storage_size(8)];
+    alignas(std::max_align_t) std::byte buf_b[FixedVector<int>::storage_size(4)];
+    auto a = FixedVector<int>::create(buf_a, sizeof(buf_a));
+    auto b = FixedVector<int>::create(buf_b, sizeof(buf_b));
+
+    a.assign_range(std::views::iota(0, 4));
+    a.insert_range(a.begin() + 2, std::views::iota(10, 12));
+    a.append_range(std::vector<int>{20});
+    ASSERT_EQ(a.size(), 7);
+    ASSERT_EQ(a[2], 10);
+    ASSERT_EQ(*a.rbegin(), 20);
+    ASSERT_EQ(std::vector<int>(a.rbegin(), a.rend()).front(), 20);
+
+    // last is clamped to end(), like StaticVector
+    a.erase(a.begin() + 6, a.begin() + 8);
+    ASSERT_EQ(a.size(), 6);
+
+    auto tail = a.splitoff<8>(a.begin() + 4);
+    ASSERT_EQ(a.size(), 4);
+    ASSERT_EQ(tail.size(), 2);
+    ASSERT_EQ(tail[0], 2);
+
+    b.assign({7, 8});
+    swap(a, b);
+    ASSERT_EQ(a.size(), 2);
+    ASSERT_EQ(a[1], 8);
+    ASSERT_EQ(b.size(), 4);
+    ASSERT_EQ(b[2], 10);
+
+    a.assign({1, 2, 3, 4, 5});
+    ASSERT_THROW(a.swap(b), std::length_error);
+}
+
+TEST(FixedVector, shared_memory)
+{
+    constexpr std::size_t bytes = FixedVector<int>::storage_size(64);
+    void *mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(mem, MAP_FAILED);
+
+    auto vec = FixedVector<int>::create(mem, bytes);
+    vec.assign({1, 2, 3});
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        auto child = FixedVector<int>::attach(mem);
+        child.push_back(child.size() == 3 ? 4 : -1);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    ASSERT_EQ(vec.size(), 4);
+    ASSERT_EQ(vec.back(), 4);
+    munmap(mem, bytes);
+}
+
+TEST(FixedVector, spare_capacity)
+{
+    alignas(std::max_align_t) std::byte buf[FixedVector<char>::storage_size(8)];
+    auto vec = FixedVector<char>::create(buf, sizeof(buf));
+    int fds[2];
+
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "abcdefghij", 10), 10);
+    close(fds[1]);
+
+    vec.push_back('>');
+    auto spare = vec.spare_capacity();
+    ssize_t got = read(fds[0], spare.data(), spare.size());
+    close(fds[0]);
+
+    ASSERT_EQ(got, 7);
+    vec.commit(got);
+    ASSERT_EQ(std::string_view(vec.data(), vec.size()), ">abcdefg");
+    ASSERT_THROW(vec.commit(1), std::length_error);
+
+    vec.resize_for_overwrite(3);
+    ASSERT_EQ(std::string_view(vec.data(), vec.size()), ">ab");
+}
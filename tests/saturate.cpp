@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include <staticjaggedvector.hpp>
+
+static_assert(STATICVEC_OVERFLOW_POLICY == STATICVEC_OVERFLOW_SATURATE);
+
+TEST(Saturate, jagged_rows)
+{
+    StaticJaggedVector<char, 16, 2> rows;
+
+    ASSERT_EQ(rows.push_row({'a', 'b'}), 0);
+    ASSERT_EQ(rows.push_row({'c'}), 1);
+
+    // A row that does not fit is dropped, not merged into the last one
+    ASSERT_EQ(rows.push_row({'d', 'e'}), rows.npos);
+    ASSERT_EQ(rows.add_row(), rows.npos);
+    ASSERT_EQ(rows.size(), 2);
+    ASSERT_EQ(rows[0].size(), 2);
+    ASSERT_EQ(rows[1].size(), 1);
+    ASSERT_EQ(rows.element_count(), 3);
+}
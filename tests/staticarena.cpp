@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticarena.hpp>
+
+TEST(StaticArena, containers)
+{
+    StaticArena<4096> arena;
+
+    std::pmr::vector<int> vec(&arena);
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+
+    std::pmr::string str("a string too long for the small string buffer", &arena);
+    std::pmr::map<int, std::pmr::string> map(&arena);
+    map.emplace(1, "one");
+    map.emplace(2, "two");
+
+    ASSERT_EQ(vec[99], 99);
+    ASSERT_EQ(map.at(2), "two");
+    ASSERT_GT(arena.used(), 100 * sizeof(int));
+    ASSERT_LE(arena.used(), arena.capacity());
+
+    std::pmr::vector<std::uint8_t> big(&arena);
+    ASSERT_THROW(big.resize(8192), std::bad_alloc);
+}
+
+TEST(StaticArena, rewind)
+{
+    StaticArena<256> arena;
+
+    void *a = arena.allocate(10, 1);
+    auto marker = arena.mark();
+    void *b = arena.allocate(16, 16);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b) % 16, 0);
+    ASSERT_EQ(arena.used(), 32);
+
+    // The most recent allocation is given back
+    arena.deallocate(b, 16, 16);
+    ASSERT_EQ(arena.used(), 16);
+
+    ASSERT_NE(arena.allocate(64, 8), nullptr);
+    arena.rewind(marker);
+    ASSERT_EQ(arena.used(), 10);
+    ASSERT_EQ(arena.allocate(1, 1), static_cast<std::uint8_t *>(a) + 10);
+
+    arena.release();
+    ASSERT_EQ(arena.used(), 0);
+    ASSERT_EQ(arena.allocate(4, 4), a);
+}
+
+TEST(StaticArena, upstream)
+{
+    StaticArena<64> arena(std::pmr::new_delete_resource());
+    std::pmr::vector<std::uint64_t> vec(&arena);
+
+    vec.resize(4);
+    ASSERT_EQ(arena.used(), 32);
+
+    // Too big for the buffer: served and freed by the upstream resource
+    vec.resize(100);
+    vec.clear();
+    vec.shrink_to_fit();
+    ASSERT_TRUE(arena.is_equal(arena));
+    ASSERT_FALSE(arena.is_equal(*std::pmr::new_delete_resource()));
+}
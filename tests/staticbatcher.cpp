@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticbatcher.hpp>
+
+namespace {
+
+struct FakeClock {
+    using rep = long;
+    using period = std::milli;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<FakeClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now()
+    {
+        return current;
+    }
+};
+
+} // namespace
+
+TEST(StaticBatcher, flush_triggers)
+{
+    std::vector<std::vector<int>> batches;
+    auto sink = [&](std::span<int> batch) {
+        batches.emplace_back(batch.begin(), batch.end());
+    };
+
+    {
+        StaticBatcher<int, 4, decltype(sink), false, FakeClock>
+            batcher(sink, FakeClock::duration(10));
+
+        for (int i = 0; i < 6; ++i) {
+            batcher.push(i);
+        }
+        ASSERT_EQ(batches.size(), 1);
+        ASSERT_EQ(batches[0], (std::vector<int>{0, 1, 2, 3}));
+        ASSERT_EQ(batcher.pending(), 2);
+        ASSERT_EQ(*batcher.deadline(), FakeClock::time_point(FakeClock::duration(10)));
+
+        FakeClock::current += FakeClock::duration(5);
+        ASSERT_FALSE(batcher.poll());
+        FakeClock::current += FakeClock::duration(5);
+        ASSERT_TRUE(batcher.poll());
+        ASSERT_EQ(batches.back(), (std::vector<int>{4, 5}));
+        ASSERT_FALSE(batcher.deadline());
+
+        // A late push flushes as well
+        batcher.push(6);
+        FakeClock::current += FakeClock::duration(20);
+        batcher.push(7);
+        ASSERT_EQ(batches.back(), (std::vector<int>{6, 7}));
+
+        batcher.push(8);
+        batcher.flush();
+        ASSERT_EQ(batches.back(), (std::vector<int>{8}));
+        batcher.push(9);
+
+        auto stats = batcher.stats();
+        ASSERT_EQ(stats.batches, 4);
+        ASSERT_EQ(stats.items, 9);
+        ASSERT_EQ(stats.full_flushes, 1);
+        ASSERT_EQ(stats.deadline_flushes, 2);
+        ASSERT_EQ(stats.max_batch, 4);
+        ASSERT_EQ(stats.max_latency, FakeClock::duration(20));
+    }
+
+    ASSERT_EQ(batches.back(), (std::vector<int>{9}));
+}
+
+TEST(StaticBatcher, throwing_sink)
+{
+    int calls = 0;
+    auto sink = [&](std::span<int>) {
+        calls++;
+        throw std::runtime_error("sink");
+    };
+
+    {
+        StaticBatcher<int, 4, decltype(sink)> batcher(sink);
+
+        batcher.push(1);
+        ASSERT_THROW(batcher.flush(), std::runtime_error);
+        ASSERT_EQ(batcher.pending(), 0);
+
+        // Destroyed with a pending item: the exception does not escape
+        batcher.push(2);
+    }
+
+    ASSERT_EQ(calls, 2);
+}
+
+TEST(StaticBatcher, concurrent)
+{
+    std::atomic<long> total = 0;
+    std::atomic<long> count = 0;
+    auto sink = [&](std::span<long> batch) {
+        total += std::accumulate(batch.begin(), batch.end(), 0L);
+        count += batch.size();
+        std::this_thread::yield();
+    };
+
+    {
+        StaticBatcher<long, 16, decltype(sink), true> batcher(sink);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (long i = 1; i <= 1000; ++i) {
+                    batcher.push(i);
+                }
+            });
+        }
+
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+
+    ASSERT_EQ(count.load(), 4000);
+    ASSERT_EQ(total.load(), 4 * 500500);
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticgapvector.hpp>
+
+TEST(StaticGapVector, cursor_edits)
+{
+    StaticGapVector<char, 16> buf;
+    std::string_view hello = "hello world";
+
+    buf.insert_range(0, hello);
+    ASSERT_EQ(buf.size(), 11);
+    ASSERT_EQ(buf.cursor(), 11);
+
+    buf.erase(5, 6);
+    buf.insert_range(5, std::string_view(", gap"));
+    buf.insert(0, '>');
+    ASSERT_EQ(buf.cursor(), 1);
+    ASSERT_EQ(buf[0], '>');
+    ASSERT_EQ(buf.back(), 'p');
+
+    auto flat = buf.linearize();
+    ASSERT_EQ(std::string_view(flat.data(), flat.size()), ">hello, gap");
+    ASSERT_EQ(buf.cursor(), buf.size());
+
+    buf.insert_range(0, std::string_view("12345"));
+    ASSERT_EQ(buf.size(), 16);
+    ASSERT_THROW(buf.insert(3, 'x'), std::length_error);
+    ASSERT_THROW(buf.move_cursor(17), std::out_of_range);
+    ASSERT_THROW(buf.at(16), std::out_of_range);
+}
+
+TEST(StaticGapVector, copy_and_move)
+{
+    StaticGapVector<std::string, 8> a = {"a", "b", "c"};
+    a.move_cursor(1);
+
+    StaticGapVector<std::string, 8> b(a);
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(b.cursor(), 1);
+
+    StaticGapVector<std::string, 8> c(std::move(b));
+    ASSERT_EQ(a, c);
+    ASSERT_TRUE(b.empty());
+
+    b = c;
+    c.insert(1, "x");
+    ASSERT_EQ(c[1], "x");
+    b = std::move(c);
+    ASSERT_EQ(b.size(), 4);
+    ASSERT_EQ(b[2], "b");
+}
+
+TEST(StaticGapVector, random_edits)
+{
+    StaticGapVector<int, 32> vec;
+    std::vector<int> model;
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 3000; ++i) {
+        std::size_t pos = rng() % (model.size() + 1);
+
+        if (model.size() < vec.capacity() && (model.empty() || rng() % 2)) {
+            vec.insert(pos, i);
+            model.insert(model.begin() + pos, i);
+        } else {
+            std::size_t count = std::min<std::size_t>(rng() % 3 + 1, model.size() - pos);
+
+            vec.erase(pos, count);
+            model.erase(model.begin() + pos, model.begin() + pos + count);
+        }
+
+        ASSERT_TRUE(std::equal(vec.begin(), vec.end(), model.begin(), model.end()));
+    }
+
+    auto flat = vec.linearize();
+    ASSERT_TRUE(std::equal(flat.begin(), flat.end(), model.begin(), model.end()));
+}
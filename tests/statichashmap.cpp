@@ -0,0 +1,244 @@
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <gtest/gtest.h>
+#include <statichashmap.hpp>
+
+TEST(StaticHashMap, basic)
+{
+    StaticHashMap<int, std::string, 8> map;
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.insert({1, "one"}).second);
+    ASSERT_FALSE(map.insert({1, "uno"}).second);
+    ASSERT_EQ(map.at(1), "one");
+
+    auto [it, inserted] = map.try_emplace(2, 3, 'x');
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->first, 2);
+    ASSERT_EQ(it->second, "xxx");
+
+    map[3] = "three";
+    ASSERT_EQ(map[3], "three");
+    ASSERT_FALSE(map.insert_or_assign(3, "drei").second);
+    ASSERT_EQ(map.at(3), "drei");
+    ASSERT_EQ(map.size(), 3);
+
+    ASSERT_TRUE(map.contains(2));
+    ASSERT_EQ(map.count(4), 0);
+    ASSERT_EQ(map.find(4), map.end());
+    ASSERT_THROW(map.at(4), std::out_of_range);
+
+    ASSERT_EQ(map.erase(2), 1);
+    ASSERT_EQ(map.erase(2), 0);
+    ASSERT_EQ(map.size(), 2);
+
+    std::size_t count = 0;
+    for (const auto &[key, val] : map) {
+        ASSERT_EQ(map.at(key), val);
+        count++;
+    }
+    ASSERT_EQ(count, map.size());
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(StaticHashMap, full)
+{
+    StaticHashMap<int, int, 20> map;
+
+    for (int i = 0; i < 20; ++i) {
+        map[i] = i;
+    }
+
+    ASSERT_EQ(map.size(), map.capacity());
+    ASSERT_THROW(map[20] = 20, std::length_error);
+    ASSERT_THROW(map.insert({21, 21}), std::length_error);
+
+    // Existing keys are still found and updated
+    map[5] = 50;
+    ASSERT_EQ(map.at(5), 50);
+
+    map.erase(map.find(0));
+    ASSERT_NO_THROW(map[20] = 20);
+    ASSERT_FALSE(map.contains(0));
+}
+
+// Random churn keeps the table near its load limit so that tombstones pile up
+// and get rehashed away
+TEST(StaticHashMap, churn)
+{
+    StaticHashMap<int, int, 100> map;
+    std::unordered_map<int, int> model;
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = rng() % 400;
+
+        if (rng() % 2 == 0 && model.size() < 100) {
+            map[key] = i;
+            model[key] = i;
+        } else {
+            ASSERT_EQ(map.erase(key), model.erase(key));
+        }
+
+        ASSERT_EQ(map.size(), model.size());
+    }
+
+    for (int key = 0; key < 400; ++key) {
+        auto it = model.find(key);
+
+        if (it == model.end()) {
+            ASSERT_FALSE(map.contains(key));
+        } else {
+            ASSERT_EQ(map.at(key), it->second);
+        }
+    }
+
+    std::size_t count = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        count++;
+    }
+    ASSERT_EQ(count, model.size());
+}
+
+TEST(StaticHashMap, erase_iteration)
+{
+    StaticHashMap<int, int, 50> map;
+
+    for (int i = 0; i < 50; ++i) {
+        map[i] = i;
+    }
+
+    for (auto it = map.begin(); it != map.end();) {
+        it = it->first % 2 == 0 ? map.erase(it) : std::next(it);
+    }
+
+    ASSERT_EQ(map.size(), 25);
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_EQ(map.contains(i), i % 2 == 1);
+    }
+}
+
+struct string_hash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view s) const
+    {
+        return std::hash<std::string_view>()(s);
+    }
+};
+
+TEST(StaticHashMap, heterogeneous)
+{
+    StaticHashMap<std::string, int, 16, string_hash, std::equal_to<>> map{
+        {"one", 1}, {"two", 2}};
+
+    ASSERT_EQ(map.at(std::string_view("two")), 2);
+    ASSERT_TRUE(map.contains("one"));
+    ASSERT_EQ(map.erase(std::string_view("one")), 1);
+    ASSERT_FALSE(map.contains("one"));
+
+    // Without transparent functors the key is converted
+    StaticHashMap<std::string, int, 16> plain{{"one", 1}};
+    ASSERT_TRUE(plain.contains("one"));
+}
+
+TEST(StaticHashMap, copy)
+{
+    StaticHashMap<int, std::string, 32> map;
+
+    for (int i = 0; i < 32; ++i) {
+        map[i] = std::to_string(i);
+    }
+    map.erase(3);
+
+    StaticHashMap<int, std::string, 32> copy(map);
+    ASSERT_EQ(copy.size(), 31);
+    ASSERT_EQ(copy.at(7), "7");
+    ASSERT_FALSE(copy.contains(3));
+
+    map.clear();
+    map = copy;
+    ASSERT_EQ(map.size(), 31);
+    ASSERT_EQ(map.at(31), "31");
+}
+
+TEST(StaticHashMap, move)
+{
+    using Map = StaticHashMap<int, std::unique_ptr<int>, 16>;
+    Map map;
+
+    for (int i = 0; i < 10; ++i) {
+        map.try_emplace(i, std::make_unique<int>(i * i));
+    }
+    const int *nine = map.at(3).get();
+
+    Map moved(std::move(map));
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(moved.size(), 10);
+    ASSERT_EQ(moved.at(3).get(), nine);
+
+    map.try_emplace(42, std::make_unique<int>(0));
+    map = std::move(moved);
+    ASSERT_EQ(map.size(), 10);
+    ASSERT_FALSE(map.contains(42));
+    ASSERT_EQ(*map.at(9), 81);
+}
+
+// Hashes differently per seed, so lookups only work with the right seed
+struct seeded_hash {
+    std::size_t seed = 0;
+
+    std::size_t operator()(int key) const
+    {
+        return std::hash<int>()(key) ^ seed;
+    }
+};
+
+TEST(StaticHashMap, functors_copied)
+{
+    using Map = StaticHashMap<int, int, 64, seeded_hash>;
+    Map seeded(seeded_hash{0x9e3779b97f4a7c15});
+    Map plain;
+
+    for (int i = 0; i < 64; ++i) {
+        seeded[i] = i;
+    }
+
+    plain = seeded;
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_EQ(plain.at(i), i);
+    }
+
+    Map other;
+    other = std::move(seeded);
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_EQ(other.at(i), i);
+    }
+}
+
+TEST(StaticHashSet, basic)
+{
+    StaticHashSet<int, 10> set{3, 1, 4, 1, 5};
+
+    ASSERT_EQ(set.size(), 4);
+    ASSERT_TRUE(set.contains(4));
+    ASSERT_FALSE(set.insert(5).second);
+    ASSERT_EQ(*set.insert(9).first, 9);
+    ASSERT_EQ(*set.find(3), 3);
+
+    ASSERT_EQ(set.erase(3), 1);
+    ASSERT_EQ(set.find(3), set.end());
+
+    int sum = 0;
+    for (int key : set) {
+        sum += key;
+    }
+    ASSERT_EQ(sum, 1 + 4 + 5 + 9);
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticheap.hpp>
+
+TEST(StaticHeap, push_pop)
+{
+    StaticHeap<int, 32> heap;
+
+    for (int i : {5, 1, 9, 3, 7, 2, 8, 6, 4, 0}) {
+        heap.push(i);
+    }
+
+    ASSERT_EQ(heap.size(), 10);
+
+    for (int expected = 9; expected >= 0; --expected) {
+        ASSERT_EQ(heap.top(), expected);
+        heap.pop();
+    }
+
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(StaticHeap, heapify_replace_top)
+{
+    std::vector<int> src = {12, 4, 18, 7, 1, 15, 9, 3, 20, 11, 6};
+    StaticHeap<int, 16, std::greater<int>, 2> heap(src);
+
+    ASSERT_EQ(heap.top(), 1);
+
+    heap.replace_top(10);
+    ASSERT_EQ(heap.top(), 3);
+
+    std::vector<int> out;
+    while (!heap.empty()) {
+        out.push_back(heap.top());
+        heap.pop();
+    }
+
+    ASSERT_TRUE(std::is_sorted(out.begin(), out.end()));
+    ASSERT_EQ(out.size(), src.size());
+}
+
+namespace {
+
+struct Timer {
+    int deadline;
+    int id;
+};
+
+struct TimerOrder {
+    bool operator()(const Timer &a, const Timer &b) const
+    {
+        return a.deadline > b.deadline;
+    }
+};
+
+struct TimerIndex {
+    std::size_t *positions;
+
+    void operator()(const Timer &t, std::size_t pos) const
+    {
+        positions[t.id] = pos;
+    }
+};
+
+}
+
+TEST(StaticHeap, decrease_key)
+{
+    std::size_t positions[8] = {};
+    StaticHeap<Timer, 8, TimerOrder, 4, TimerIndex> heap(TimerOrder(),
+                                                        TimerIndex{positions});
+
+    for (int id = 0; id < 8; ++id) {
+        heap.push(Timer{100 + id * 10, id});
+    }
+
+    for (int id = 0; id < 8; ++id) {
+        ASSERT_EQ(heap[positions[id]].id, id);
+    }
+
+    heap.modify(positions[6], [](Timer &t) { t.deadline = 5; });
+    ASSERT_EQ(heap.top().id, 6);
+
+    heap.erase(positions[6]);
+    heap.erase(positions[3]);
+    ASSERT_EQ(heap.size(), 6);
+
+    int prev = 0;
+    while (!heap.empty()) {
+        ASSERT_NE(heap.top().id, 3);
+        ASSERT_LE(prev, heap.top().deadline);
+        prev = heap.top().deadline;
+        heap.pop();
+    }
+}
+
+TEST(StaticHeap, priority_queue_adaptor)
+{
+    std::priority_queue<int, StaticVector<int, 8>> queue;
+
+    queue.push(3);
+    queue.push(8);
+    queue.push(5);
+
+    ASSERT_EQ(queue.top(), 8);
+    queue.pop();
+    ASSERT_EQ(queue.top(), 5);
+}
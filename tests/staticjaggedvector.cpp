@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticjaggedvector.hpp>
+
+TEST(StaticJaggedVector, rows)
+{
+    StaticJaggedVector<int, 16, 4> adj;
+
+    static_assert(sizeof(adj) < sizeof(StaticVector<StaticVector<int, 16>, 4>));
+
+    ASSERT_EQ(adj.push_row({1, 2}), 0);
+    ASSERT_EQ(adj.push_row(std::vector<int>{}), 1);
+    ASSERT_EQ(adj.push_row({3, 4, 5}), 2);
+
+    ASSERT_EQ(adj.size(), 3);
+    ASSERT_EQ(adj.element_count(), 5);
+    ASSERT_EQ(adj[0].size(), 2);
+    ASSERT_TRUE(adj[1].empty());
+    ASSERT_EQ(adj[2][1], 4);
+
+    adj.add_row();
+    adj.push_back(6);
+    adj.push_back(7);
+    ASSERT_EQ(adj[3].size(), 2);
+    ASSERT_EQ(adj[3].back(), 7);
+
+    auto flat = adj.flat();
+    ASSERT_EQ(std::accumulate(flat.begin(), flat.end(), 0), 28);
+
+    ASSERT_THROW(adj.push_row({8}), std::length_error);
+    ASSERT_THROW(adj.at(4), std::out_of_range);
+
+    adj.pop_row();
+    ASSERT_EQ(adj.size(), 3);
+    ASSERT_EQ(adj.element_count(), 5);
+
+    std::size_t total = 0;
+    for (auto row : adj) {
+        total += row.size();
+    }
+    ASSERT_EQ(total, 5);
+
+    const auto &cadj = adj;
+    ASSERT_EQ(std::count_if(cadj.begin(), cadj.end(),
+                            [](auto row) { return row.empty(); }), 1);
+}
+
+TEST(StaticJaggedVector, push_row_rollback)
+{
+    using Jagged = StaticJaggedVector<int, 4, 4>;
+    static_assert(std::random_access_iterator<Jagged::iterator>);
+    static_assert(std::random_access_iterator<Jagged::const_iterator>);
+
+    Jagged rows;
+    rows.push_row({1});
+
+    // A single pass range only overflows after some elements were appended
+    std::istringstream in("2 3 4 5 6");
+    ASSERT_THROW(rows.push_row(std::views::istream<int>(in)), std::length_error);
+    ASSERT_EQ(rows.size(), 1);
+    ASSERT_EQ(rows.element_count(), 1);
+    ASSERT_EQ(rows[0].size(), 1);
+
+    ASSERT_EQ(rows.push_row({7, 8}), 1);
+    ASSERT_EQ(rows[1][0], 7);
+    ASSERT_EQ(rows.element_count(), 3);
+}
@@ -0,0 +1,56 @@
+#include <cstdint>
+#include <numeric>
+#include <gtest/gtest.h>
+#include <staticnumeric.hpp>
+
+TEST(StaticNumeric, reductions)
+{
+    StaticVector<float, 64> f;
+    for (int i = 0; i < 61; ++i) {
+        f.push_back(static_cast<float>((i * 37) % 61) - 30.0f);
+    }
+
+    ASSERT_FLOAT_EQ(staticvec::sum(f), std::accumulate(f.begin(), f.end(), 0.0f));
+    ASSERT_EQ(staticvec::min(f), -30.0f);
+    ASSERT_EQ(staticvec::max(f), 30.0f);
+    ASSERT_EQ(staticvec::minmax(f), std::make_pair(-30.0f, 30.0f));
+    ASSERT_EQ(staticvec::argmin(f), 0);
+    ASSERT_EQ(f[staticvec::argmax(f)], 30.0f);
+
+    StaticVector<std::int32_t, 7> small = {4, -2, 9, 9, -2, 0, 1};
+    ASSERT_EQ(staticvec::sum(small), 19);
+    ASSERT_EQ(staticvec::argmin(small), 1);
+    ASSERT_EQ(staticvec::argmax(small), 2);
+
+    StaticVector<double, 3> one = {2.5};
+    ASSERT_EQ(staticvec::minmax(one), std::make_pair(2.5, 2.5));
+    ASSERT_EQ(staticvec::sum(StaticVector<double, 3>()), 0.0);
+}
+
+TEST(StaticNumeric, elementwise)
+{
+    StaticVector<float, 64> a(1.0f, 50);
+    StaticVector<float, 64> b;
+    for (int i = 0; i < 50; ++i) {
+        b.push_back(static_cast<float>(i));
+    }
+
+    ASSERT_FLOAT_EQ(staticvec::dot(a, b), 49 * 50 / 2);
+
+    staticvec::add(a, b);
+    ASSERT_EQ(a[10], 11.0f);
+    staticvec::mul(a, 2);
+    ASSERT_EQ(a[10], 22.0f);
+    staticvec::fma(a, 0.5f, b);
+    ASSERT_EQ(a[10], 21.0f);
+    staticvec::fma(a, b, -1.0f);
+    ASSERT_EQ(a[3], (4.0f + 3.0f) * 3.0f - 1.0f);
+
+    // Only the common prefix is touched
+    StaticVector<std::int64_t, 16> x(1, 16);
+    StaticVector<std::int64_t, 4> y = {1, 2, 3};
+    staticvec::add(x, y);
+    ASSERT_EQ(x[2], 4);
+    ASSERT_EQ(x[3], 1);
+    ASSERT_EQ(staticvec::dot(x, y), 2 + 6 + 12);
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticsegmentedvector.hpp>
+
+TEST(StaticSegmentedVector, basics)
+{
+    StaticSegmentedVector<int, 4, 3> vec = {1, 2, 3, 4, 5};
+
+    ASSERT_EQ(vec.size(), 5);
+    ASSERT_EQ(vec.segment_count(), 2);
+    ASSERT_EQ(vec[4], 5);
+    ASSERT_EQ(vec.back(), 5);
+
+    int &first = vec.front();
+    for (int i = 6; i <= 12; ++i) {
+        vec.push_back(i);
+    }
+    ASSERT_EQ(&first, &vec[0]);
+    ASSERT_EQ(vec.size(), vec.capacity());
+    ASSERT_THROW(vec.push_back(13), std::length_error);
+    ASSERT_THROW(vec.insert(vec.begin(), 0), std::length_error);
+    ASSERT_THROW(vec.at(12), std::out_of_range);
+
+    auto it = vec.erase(std::find(vec.begin(), vec.end(), 6));
+    ASSERT_EQ(*it, 7);
+    it = vec.insert(vec.begin(), 0);
+    ASSERT_EQ(*it, 0);
+
+    std::vector<int> expect = {0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12};
+    ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expect.begin(), expect.end()));
+
+    std::size_t total = 0;
+    for (auto seg : vec.segments()) {
+        total += seg.size();
+    }
+    ASSERT_EQ(total, vec.size());
+
+    vec.clear();
+    ASSERT_TRUE(vec.empty());
+    ASSERT_EQ(vec.begin(), vec.end());
+}
+
+TEST(StaticSegmentedVector, random_edits)
+{
+    StaticSegmentedVector<int, 4, 6> vec;
+    std::vector<int> model;
+    std::mt19937 rng(42);
+
+    for (int i = 0; i < 4000; ++i) {
+        std::size_t pos = model.empty() ? 0 : rng() % (model.size() + 1);
+        bool grow = model.size() < vec.capacity() && (model.empty() || rng() % 3 != 0);
+
+        if (grow) {
+            vec.insert(std::next(vec.cbegin(), pos), i);
+            model.insert(model.begin() + pos, i);
+        } else {
+            pos = std::min(pos, model.size() - 1);
+            vec.erase(std::next(vec.cbegin(), pos));
+            model.erase(model.begin() + pos);
+        }
+
+        ASSERT_EQ(vec.size(), model.size());
+        ASSERT_TRUE(std::equal(vec.begin(), vec.end(), model.begin(), model.end()));
+    }
+
+    std::vector<int> reversed(model.rbegin(), model.rend());
+    ASSERT_TRUE(std::equal(std::make_reverse_iterator(vec.end()),
+                           std::make_reverse_iterator(vec.begin()),
+                           reversed.begin(), reversed.end()));
+}
+
+// A middle insert into a full chunk spills into a neighbour with room rather
+// than take the last free chunk, which push_back then uses without moving
+TEST(StaticSegmentedVector, stable_push_back)
+{
+    StaticSegmentedVector<int, 4, 3> vec = {0, 1, 2, 3};
+
+    vec.insert(std::next(vec.cbegin()), 10);
+    vec.push_back(4);
+    vec.push_back(5);
+    vec.insert(std::next(vec.cbegin(), 5), 11);
+    ASSERT_EQ(vec.segment_count(), 2);
+
+    int &last = vec.back();
+    for (int i = 6; i < 10; ++i) {
+        vec.push_back(i);
+    }
+    ASSERT_EQ(&last, &vec[7]);
+    ASSERT_EQ(last, 5);
+
+    std::vector<int> expect = {0, 10, 1, 2, 3, 11, 4, 5, 6, 7, 8, 9};
+    ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expect.begin(), expect.end()));
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticsetops.hpp>
+
+template<typename T, std::size_t S>
+static StaticVector<T, S> random_set(std::mt19937 &rng, std::size_t n, T range)
+{
+    std::vector<T> vals;
+
+    while (vals.size() < n) {
+        vals.push_back(static_cast<T>(rng() % range));
+        std::sort(vals.begin(), vals.end());
+        vals.erase(std::unique(vals.begin(), vals.end()), vals.end());
+    }
+
+    return StaticVector<T, S>(vals.begin(), vals.end());
+}
+
+template<typename T>
+static void check_set_ops()
+{
+    std::mt19937 rng(11);
+    const std::size_t sizes[][2] = {{0, 10}, {37, 41}, {100, 90}, {3, 200}, {200, 5}, {64, 64}};
+
+    for (const auto &[na, nb] : sizes) {
+        for (T range : {T(150), T(400), T(5000)}) {
+            auto a = random_set<T, 256>(rng, std::min<std::size_t>(na, range), range);
+            auto b = random_set<T, 256>(rng, std::min<std::size_t>(nb, range), range);
+            StaticVector<T, 512> out;
+            std::vector<T> expect;
+
+            staticvec::set_intersection(a, b, out);
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                  std::back_inserter(expect));
+            ASSERT_TRUE(std::ranges::equal(out, expect));
+            ASSERT_EQ(staticvec::intersect_count(a, b), expect.size());
+
+            expect.clear();
+            staticvec::set_union(a, b, out);
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                           std::back_inserter(expect));
+            ASSERT_TRUE(std::ranges::equal(out, expect));
+
+            expect.clear();
+            staticvec::set_difference(a, b, out);
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                std::back_inserter(expect));
+            ASSERT_TRUE(std::ranges::equal(out, expect));
+
+            expect.clear();
+            staticvec::set_difference(b, a, out);
+            std::set_difference(b.begin(), b.end(), a.begin(), a.end(),
+                                std::back_inserter(expect));
+            ASSERT_TRUE(std::ranges::equal(out, expect));
+        }
+    }
+}
+
+TEST(StaticSetOps, uint32)
+{
+    check_set_ops<std::uint32_t>();
+}
+
+TEST(StaticSetOps, uint64)
+{
+    check_set_ops<std::uint64_t>();
+}
+
+TEST(StaticSetOps, scalar)
+{
+    check_set_ops<std::int16_t>();
+}
+
+TEST(StaticSetOps, capacity)
+{
+    StaticVector<std::uint32_t, 8> a = {1, 2, 3, 4, 5, 6, 7, 8};
+    StaticVector<std::uint32_t, 8> b = {2, 4, 6, 8, 10, 12, 14, 16};
+    StaticVector<std::uint32_t, 4> small;
+
+    // The bound exceeds the destination but the result fits
+    staticvec::set_intersection(a, b, small);
+    ASSERT_EQ(small, (StaticVector<std::uint32_t, 4>{2, 4, 6, 8}));
+
+    // A result that does not fit leaves the destination alone
+    ASSERT_THROW(staticvec::set_union(a, b, small), std::length_error);
+    ASSERT_EQ(small, (StaticVector<std::uint32_t, 4>{2, 4, 6, 8}));
+}
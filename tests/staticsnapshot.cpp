@@ -0,0 +1,125 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticsnapshot.hpp>
+
+TEST(StaticVectorSnapshot, publish)
+{
+    StaticVectorSnapshot<int, 8> snap(StaticVector<int, 8>{1, 2, 3});
+
+    {
+        auto before = snap.read();
+        auto again = snap.read();
+        ASSERT_EQ(&*before, &*again);
+
+        snap.update([](StaticVector<int, 8> &vec) { vec.push_back(4); });
+
+        // An existing handle keeps seeing its version
+        ASSERT_EQ(before->size(), 3);
+        ASSERT_EQ(snap.read()->size(), 4);
+        ASSERT_EQ(snap.read()->back(), 4);
+    }
+
+    snap.store(StaticVector<int, 8>{7});
+    ASSERT_EQ(snap.read()->size(), 1);
+    ASSERT_EQ((*snap.read())[0], 7);
+}
+
+TEST(StaticVectorSnapshot, concurrent_readers)
+{
+    StaticVectorSnapshot<int, 64, 3> snap(StaticVector<int, 64>(0, 64));
+    std::atomic<bool> done = false;
+    std::atomic<int> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto view = snap.read();
+                for (int v : *view) {
+                    if (v != view->front()) {
+                        torn++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int gen = 1; gen <= 2000; ++gen) {
+        snap.update([gen](StaticVector<int, 64> &vec) {
+            for (int &v : vec) {
+                v = gen;
+            }
+        });
+    }
+
+    done = true;
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(snap.read()->front(), 2000);
+}
+
+// More reader threads than pins: readers that find no free pin fall back
+// to the per-buffer count instead of waiting
+TEST(StaticVectorSnapshot, shared_pins)
+{
+    StaticVectorSnapshot<int, 16, 3, 2> snap(StaticVector<int, 16>(0, 16));
+    std::atomic<bool> done = false;
+    std::atomic<int> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 6; ++i) {
+        readers.emplace_back([&] {
+            int last = 0;
+
+            while (!done.load()) {
+                auto view = snap.read();
+
+                // Versions are never seen going backwards
+                if (view->front() < last) {
+                    torn++;
+                }
+                last = view->front();
+
+                for (int v : *view) {
+                    if (v != last) {
+                        torn++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int gen = 1; gen <= 1000; ++gen) {
+        snap.store(StaticVector<int, 16>(gen, 16));
+    }
+
+    done = true;
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(snap.read()->back(), 1000);
+}
+
+TEST(StaticVectorSnapshot, more_handles_than_pins)
+{
+    StaticVectorSnapshot<int, 4, 3, 1> snap(StaticVector<int, 4>{1});
+
+    auto first = snap.read();
+    auto second = snap.read();
+    auto third = snap.read();
+    ASSERT_EQ(second->front(), 1);
+
+    // Both handles without a pin keep their buffer from being reused
+    snap.store(StaticVector<int, 4>{2});
+    snap.store(StaticVector<int, 4>{3});
+    ASSERT_EQ(first->front(), 1);
+    ASSERT_EQ(third->front(), 1);
+    ASSERT_EQ(snap.read()->front(), 3);
+}
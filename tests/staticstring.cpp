@@ -0,0 +1,130 @@
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <gtest/gtest.h>
+#include <staticstring.hpp>
+
+TEST(StaticString, basics)
+{
+    StaticString<24> s("hello");
+
+    ASSERT_EQ(s.size(), 5);
+    ASSERT_EQ(s, "hello");
+    ASSERT_STREQ(s.c_str(), "hello");
+
+    s += ", ";
+    s.append("world");
+    s.push_back('!');
+    ASSERT_EQ(s, "hello, world!");
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+
+    s.insert(0, ">> ");
+    s.erase(s.size() - 1);
+    ASSERT_EQ(s, ">> hello, world");
+
+    s.insert(3, s.substr(3, 5));
+    ASSERT_EQ(s.substr(0, 8), ">> hello");
+
+    s.resize(2);
+    ASSERT_EQ(s, ">>");
+    s.resize(4, '-');
+    ASSERT_EQ(s, ">>--");
+
+    ASSERT_THROW(s.append(std::string(21, 'x')), std::length_error);
+    ASSERT_THROW(s.substr(5), std::out_of_range);
+
+    StaticString<5> exact("exact");
+    ASSERT_EQ(exact, "exact");
+
+    char buf[32] = "short";
+    StaticString<31> from_buf(buf);
+    ASSERT_EQ(from_buf.size(), 5);
+
+    // A buffer larger than the capacity is measured at run time
+    StaticString<8> from_big_buf(buf);
+    ASSERT_EQ(from_big_buf, "short");
+    static_assert(std::is_constructible_v<StaticString<8>, char (&)[32]>);
+    ASSERT_THROW((StaticString<4>(buf)), std::length_error);
+
+    const char *ptr = buf;
+    StaticString<8> from_ptr(ptr);
+    ASSERT_EQ(from_ptr, "short");
+
+    StaticString<16> full(16, 'a');
+    ASSERT_STREQ(full.c_str(), std::string(16, 'a').c_str());
+}
+
+TEST(StaticString, copy_terminates)
+{
+    StaticString<16> a("abcdefgh");
+    StaticString<16> b("xyz");
+
+    a = b;
+    ASSERT_EQ(a.size(), 3);
+    ASSERT_EQ(std::strlen(a.c_str()), a.size());
+
+    a = "abcdefgh";
+    a = std::move(b);
+    ASSERT_EQ(std::strlen(a.c_str()), a.size());
+    ASSERT_EQ(std::strlen(b.c_str()), b.size());
+
+    // Copies over storage holding earlier, longer text
+    alignas(StaticString<16>) unsigned char raw[sizeof(StaticString<16>)];
+    std::memset(raw, 'x', sizeof(raw));
+    auto *copy = ::new (raw) StaticString<16>(a);
+    ASSERT_EQ(std::strlen(copy->c_str()), copy->size());
+    copy->~StaticString<16>();
+
+    std::memset(raw, 'x', sizeof(raw));
+    auto *moved = ::new (raw) StaticString<16>(std::move(a));
+    ASSERT_EQ(std::strlen(moved->c_str()), moved->size());
+    ASSERT_EQ(*moved, "xyz");
+    moved->~StaticString<16>();
+}
+
+TEST(StaticString, search)
+{
+    StaticString<64> s("the quick brown fox jumps over the lazy dog");
+
+    ASSERT_EQ(s.find("fox"), 16);
+    ASSERT_EQ(s.find('q'), 4);
+    ASSERT_EQ(s.find('z'), 37);
+    ASSERT_EQ(s.find("cat"), StaticString<64>::npos);
+    ASSERT_EQ(s.rfind("the"), 31);
+
+    ASSERT_EQ(s.find_first_of("zyx"), 18);
+    ASSERT_EQ(s.find_first_of("zyx", 19), 37);
+    ASSERT_EQ(s.find_first_of("0123456789!?"), StaticString<64>::npos);
+    ASSERT_EQ(s.find_first_of("abcdefghijklmnopqrstuvwxyz", 3), 4);
+    ASSERT_EQ(s.find_first_not_of("the "), 4);
+    ASSERT_EQ(s.find_first_not_of("abcdefghijklmnopqrstuvwxyz "),
+              StaticString<64>::npos);
+
+    ASSERT_TRUE(s.starts_with("the"));
+    ASSERT_TRUE(s.ends_with("dog"));
+    ASSERT_TRUE(s.contains("brown"));
+}
+
+TEST(StaticString, interop)
+{
+    StaticString<8> a("abc");
+    StaticString<32> b("abd");
+
+    ASSERT_TRUE(a < b);
+    ASSERT_TRUE(a == std::string_view("abc"));
+    ASSERT_EQ(a.compare("abc"), 0);
+
+    std::unordered_set<StaticString<8>> keys;
+    keys.insert(a);
+    ASSERT_EQ(keys.count(StaticString<8>("abc")), 1);
+    ASSERT_EQ(std::hash<StaticString<8>>()(a),
+              std::hash<std::string_view>()("abc"));
+
+#ifdef STATICVEC_SUPPORT_IOSTREAM
+    std::ostringstream os;
+    os << a << b;
+    ASSERT_EQ(os.str(), "abcabd");
+#endif
+}
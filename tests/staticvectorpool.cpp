@@ -0,0 +1,80 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <staticvectorpool.hpp>
+
+TEST(StaticVectorPool, acquire_release)
+{
+    auto pool = std::make_unique<StaticVectorPool<int, 1024, 2>>();
+
+    auto a = pool->acquire();
+    auto b = pool->acquire();
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    ASSERT_NE(&*a, &*b);
+
+    a->push_back(1);
+    a->push_back(2);
+    ASSERT_EQ(a->size(), 2);
+
+    ASSERT_FALSE(pool->try_acquire());
+    ASSERT_THROW(pool->acquire(), std::length_error);
+
+    auto *first = &*a;
+    a.reset();
+    ASSERT_FALSE(a);
+
+    auto c = pool->acquire();
+    ASSERT_EQ(&*c, first);
+    ASSERT_TRUE(c->empty());
+
+    decltype(c) d = std::move(c);
+    ASSERT_FALSE(c);
+    ASSERT_TRUE(d);
+}
+
+TEST(StaticVectorPool, concurrent)
+{
+    auto pool = std::make_unique<StaticVectorPool<int, 16, 4, true>>();
+    std::atomic<int> errors = 0;
+
+    std::vector<std::thread> threads;
+    for (int id = 0; id < 4; ++id) {
+        threads.emplace_back([&, id] {
+            for (int i = 0; i < 5000; ++i) {
+                auto h = pool->try_acquire();
+                if (!h) {
+                    continue;
+                }
+
+                if (!h->empty()) {
+                    errors++;
+                }
+
+                h->assign(static_cast<std::size_t>(8), id);
+                std::this_thread::yield();
+
+                for (int v : *h) {
+                    if (v != id) {
+                        errors++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(errors.load(), 0);
+
+    std::vector<StaticVectorPool<int, 16, 4, true>::Handle> all;
+    for (int i = 0; i < 4; ++i) {
+        all.push_back(pool->acquire());
+        ASSERT_TRUE(all.back());
+    }
+    ASSERT_FALSE(pool->try_acquire());
+}
@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iomanip>
+#include <locale>
 #include <memory>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include <gtest/gtest.h>
 #include <staticvector.hpp>
 
@@ -273,3 +282,446 @@ TEST(StaticVector, assign)
     vec.assign({42, 42, 42, 42, 42});
     ASSERT_EQ(vec, expected);
 }
+
+TEST(StaticVector, relocation)
+{
+    static_assert(staticvec::is_trivially_relocatable_v<int>);
+    static_assert(staticvec::is_trivially_relocatable_v<std::unique_ptr<int>>);
+
+    StaticVector<std::unique_ptr<int>, 16> vec;
+
+    for (int i = 0; i < 6; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+
+    vec.insert(vec.begin() + 2, std::make_unique<int>(42));
+    ASSERT_EQ(vec.size(), 7);
+    ASSERT_EQ(*vec[2], 42);
+    ASSERT_EQ(*vec[3], 2);
+
+    vec.erase(vec.begin(), vec.begin() + 3);
+    ASSERT_EQ(vec.size(), 4);
+    ASSERT_EQ(*vec[0], 2);
+    ASSERT_EQ(*vec[3], 5);
+
+    StaticVector<std::unique_ptr<int>, 16> other(std::move(vec));
+    ASSERT_EQ(vec.size(), 0);
+    ASSERT_EQ(other.size(), 4);
+
+    vec.push_back(std::make_unique<int>(7));
+    vec.swap(other);
+    ASSERT_EQ(vec.size(), 4);
+    ASSERT_EQ(other.size(), 1);
+    ASSERT_EQ(*vec[0], 2);
+    ASSERT_EQ(*other[0], 7);
+}
+
+TEST(StaticVector, swap)
+{
+    StaticVector<std::string, 8> a = {"one", "two", "three"};
+    StaticVector<std::string, 8> b = {"four"};
+
+    swap(a, b);
+
+    StaticVector<std::string, 8> expected_a = {"four"};
+    StaticVector<std::string, 8> expected_b = {"one", "two", "three"};
+    ASSERT_EQ(a, expected_a);
+    ASSERT_EQ(b, expected_b);
+
+    a.erase(a.begin());
+    b.erase(b.begin() + 1);
+    expected_b = {"one", "three"};
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(b, expected_b);
+}
+
+#ifdef __cpp_lib_expected
+TEST(StaticVector, try_push_back)
+{
+    StaticVector<int, 2> vec;
+
+    auto res = vec.try_push_back(1);
+    ASSERT_TRUE(res.has_value());
+    ASSERT_EQ(**res, 1);
+
+    ASSERT_TRUE(vec.try_emplace_back(2).has_value());
+
+    res = vec.try_push_back(3);
+    ASSERT_FALSE(res.has_value());
+    ASSERT_EQ(res.error(), staticvec::errc::capacity_exceeded);
+    ASSERT_EQ(vec.size(), 2);
+}
+#endif
+
+TEST(StaticVector, alignment)
+{
+    using Stats = StaticVector<int, 8, staticvec::Align<64>>;
+    using TailSize = StaticVector<int, 20,
+          staticvec::Align<64, staticvec::SizePosition::back>>;
+
+    static_assert(alignof(Stats) == 64);
+    static_assert(sizeof(Stats) == 64);
+    static_assert(sizeof(TailSize) == 128);
+    static_assert(alignof(StaticVector<double, 3>) == alignof(double));
+
+    Stats per_core[4];
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(&per_core[1]) % 64, 0);
+
+    per_core[1] = {1, 2, 3};
+    per_core[2].push_back(4);
+
+    Stats expected = {1, 2, 3};
+    ASSERT_EQ(per_core[1], expected);
+    ASSERT_EQ(per_core[2].back(), 4);
+    ASSERT_TRUE(per_core[3].empty());
+
+    TailSize tail(7, 20);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(tail.data()) % 64, 0);
+    ASSERT_EQ(tail.size(), 20);
+    ASSERT_EQ(tail.back(), 7);
+}
+
+TEST(StaticVector, ranges)
+{
+    using Vec = StaticVector<int, 16>;
+
+    static_assert(std::ranges::contiguous_range<Vec>);
+    static_assert(std::ranges::contiguous_range<const Vec>);
+    static_assert(std::ranges::sized_range<Vec>);
+    static_assert(std::same_as<std::ranges::range_value_t<const Vec>, int>);
+
+    Vec vec = {5, 3, 8, 1, 9, 2};
+    std::ranges::sort(vec);
+
+    Vec expected = {1, 2, 3, 5, 8, 9};
+    ASSERT_EQ(vec, expected);
+    ASSERT_EQ(std::ranges::data(vec), vec.data());
+    ASSERT_EQ(*vec.rbegin(), 9);
+
+    auto odd_squares = vec
+        | std::views::filter([](int i) { return i % 2 != 0; })
+        | std::views::transform([](int i) { return i * i; });
+
+    Vec res;
+    res.append_range(odd_squares);
+    expected = {1, 9, 25, 81};
+    ASSERT_EQ(res, expected);
+
+    res.insert_range(res.begin() + 1, std::views::iota(10, 12));
+    expected = {1, 10, 11, 9, 25, 81};
+    ASSERT_EQ(res, expected);
+
+    std::istringstream in("7 6");
+    res.insert_range(res.begin(), std::views::istream<int>(in));
+    expected = {7, 6, 1, 10, 11, 9, 25, 81};
+    ASSERT_EQ(res, expected);
+
+    res.assign_range(std::views::iota(0, 3));
+    expected = {0, 1, 2};
+    ASSERT_EQ(res, expected);
+
+    Vec from(staticvec::from_range, std::views::iota(3, 6));
+    expected = {3, 4, 5};
+    ASSERT_EQ(from, expected);
+
+    Vec other;
+    ASSERT_NE(from.begin(), other.begin());
+    ASSERT_TRUE((from.begin() <=> other.begin()) != 0);
+
+    auto it = res.cbegin();
+    ASSERT_EQ(res.cend() - it, 3);
+    ASSERT_EQ(*(2 + it), 2);
+}
+
+namespace {
+
+struct Counted {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    int value;
+
+    Counted(int v) : value(v) {}
+    Counted(const Counted &o) : value(o.value) { copies++; }
+    Counted(Counted &&o) : value(o.value) { moves++; }
+    Counted& operator=(const Counted &o) { value = o.value; copies++; return *this; }
+    Counted& operator=(Counted &&o) { value = o.value; moves++; return *this; }
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+}
+
+TEST(StaticVector, forwarding)
+{
+    StaticVector<Counted, 8> vec;
+
+    Counted::reset();
+    Counted &ref = vec.emplace_back(1);
+    ASSERT_EQ(&ref, &vec.back());
+    ASSERT_EQ(Counted::copies + Counted::moves, 0);
+
+    Counted c(2);
+    vec.push_back(c);
+    vec.push_back(std::move(c));
+    ASSERT_EQ(Counted::copies, 1);
+    ASSERT_EQ(Counted::moves, 1);
+
+    Counted::reset();
+    StaticVector<Counted, 8> fill(Counted(5), 4);
+    ASSERT_EQ(Counted::copies, 4);
+
+    Counted::reset();
+    StaticVector<Counted, 8> moved(std::move(fill));
+    ASSERT_EQ(Counted::copies, 0);
+    ASSERT_EQ(moved.size(), 4);
+
+    Counted::reset();
+    auto tail = vec.splitoff(vec.begin() + 1);
+    ASSERT_EQ(Counted::copies, 0);
+    ASSERT_EQ(vec.size(), 1);
+    ASSERT_EQ(tail.size(), 2);
+    ASSERT_EQ(tail[0].value, 2);
+}
+
+TEST(StaticVector, construction_paths)
+{
+    std::string words[] = {"alpha", "beta", "gamma"};
+    StaticVector<std::string, 8> vec(std::begin(words), std::end(words));
+
+    ASSERT_EQ(vec.size(), 3);
+    ASSERT_EQ(vec[2], "gamma");
+
+    // Inserting an element of the vector itself must see the old value
+    vec.insert(vec.begin(), vec.back());
+    ASSERT_EQ(vec[0], "gamma");
+    ASSERT_EQ(vec[3], "gamma");
+
+    StaticVector<std::string, 8> other = {"x"};
+    other = vec;
+    ASSERT_EQ(other, vec);
+
+    other.assign(static_cast<std::size_t>(2), "y");
+    StaticVector<std::string, 8> expected = {"y", "y"};
+    ASSERT_EQ(other, expected);
+
+    std::istringstream in("1 2 3");
+    StaticVector<int, 4> ints(std::istream_iterator<int>(in),
+                              std::istream_iterator<int>{});
+    StaticVector<int, 4> expected_ints = {1, 2, 3};
+    ASSERT_EQ(ints, expected_ints);
+}
+
+#ifdef STATICVEC_SUPPORT_IOSTREAM
+TEST(StaticVector, ostream)
+{
+    std::ostringstream os;
+
+    StaticVector<int, 256> ints = {1, -22, 333};
+    os << ints;
+    ASSERT_EQ(os.str(), "{1, -22, 333}");
+
+    os.str("");
+    os << std::hex << ints << std::dec;
+    ASSERT_EQ(os.str(), "{1, ffffffea, 14d}");
+
+    os.str("");
+    StaticVector<char, 4> chars = {'a', 'b'};
+    os << chars;
+    ASSERT_EQ(os.str(), "{a, b}");
+
+    os.str("");
+    StaticVector<std::byte, 4> bytes = {std::byte('o'), std::byte('k')};
+    os << bytes;
+    ASSERT_EQ(os.str(), "{111, 107}");
+
+    os.str("");
+    os << std::hex << bytes << std::dec;
+    ASSERT_EQ(os.str(), "{6f, 6b}");
+
+    // Width applies to the opening brace, as with the element by element
+    // output
+    os.str("");
+    os << std::setw(3) << chars;
+    ASSERT_EQ(os.str(), "  {a, b}");
+
+    // The stream's locale is honoured
+    struct grouping : std::numpunct<char> {
+        char do_thousands_sep() const override
+        {
+            return '\'';
+        }
+
+        std::string do_grouping() const override
+        {
+            return "\3";
+        }
+    };
+
+    std::ostringstream grouped;
+    grouped.imbue(std::locale(grouped.getloc(), new grouping));
+    grouped << StaticVector<int, 2>{1000, 2};
+    ASSERT_EQ(grouped.str(), "{1'000, 2}");
+
+    // Long enough to flush the stack buffer several times
+    ints.clear();
+    std::string expected = "{";
+    for (int i = 0; i < 256; ++i) {
+        ints.push_back(i * 1000003);
+        expected += (i ? ", " : "") + std::to_string(i * 1000003);
+    }
+    expected += "}";
+
+    os.str("");
+    os << ints;
+    ASSERT_EQ(os.str(), expected);
+
+    os.str("");
+    StaticVector<double, 2> doubles = {0.5, 1.0 / 3};
+    os << doubles;
+    ASSERT_EQ(os.str(), "{0.5, 0.333333}");
+}
+#endif
+
+#ifdef __cpp_lib_format
+TEST(StaticVector, format)
+{
+    StaticVector<int, 8> ints = {1, 2, 255};
+    ASSERT_EQ(std::format("{}", ints), "[1, 2, 255]");
+    ASSERT_EQ(std::format("{:n}", ints), "1, 2, 255");
+    ASSERT_EQ(std::format("{::#x}", ints), "[0x1, 0x2, 0xff]");
+
+    StaticVector<char, 8> chars = {'h', 'i'};
+    ASSERT_EQ(std::format("{:s}", chars), "hi");
+    ASSERT_EQ(std::format("{}", chars), "[h, i]");
+
+    StaticVector<double, 4> doubles = {0.5, 2};
+    ASSERT_EQ(std::format("{}", doubles), "[0.5, 2]");
+    ASSERT_EQ(std::format("{::.2f}", doubles), "[0.50, 2.00]");
+
+    StaticVector<int, 4> empty;
+    ASSERT_EQ(std::format("{}", empty), "[]");
+}
+#endif
+
+// Compares and hashes case-insensitively, so equal values differ in bytes
+struct Letter {
+    char c;
+
+    friend bool operator ==(Letter a, Letter b)
+    {
+        return (a.c | 0x20) == (b.c | 0x20);
+    }
+};
+
+template<>
+struct std::hash<Letter> {
+    std::size_t operator()(Letter l) const
+    {
+        return std::hash<char>()(l.c | 0x20);
+    }
+};
+
+TEST(StaticVector, hash)
+{
+    using Key = StaticVector<std::uint32_t, 6>;
+    std::hash<Key> hasher;
+
+    Key a = {1, 2, 3};
+    Key b = {1, 2, 3};
+    Key c = {1, 2, 3, 0};
+
+    ASSERT_EQ(hasher(a), hasher(b));
+    ASSERT_NE(hasher(a), hasher(c));
+    ASSERT_NE(hasher(a), hasher(Key{3, 2, 1}));
+    ASSERT_NE(hasher(Key{}), hasher(Key{0}));
+
+    std::unordered_map<Key, int> cache;
+    cache[a] = 42;
+    cache[c] = 7;
+    ASSERT_EQ(cache.at(b), 42);
+    ASSERT_EQ(cache.at(c), 7);
+
+    using Words = StaticVector<std::string, 4>;
+    std::hash<Words> words;
+    ASSERT_EQ(words(Words{"a", "b"}), words(Words{"a", "b"}));
+    ASSERT_NE(words(Words{"a", "b"}), words(Words{"b", "a"}));
+
+    // Long enough for the 48 byte block loop
+    StaticVector<std::uint64_t, 16> big(7, 16);
+    StaticVector<std::uint64_t, 16> big2 = big;
+    big2[15] = 8;
+    ASSERT_NE(std::hash<decltype(big)>()(big), std::hash<decltype(big)>()(big2));
+
+    // Element hashes are used for types that are not bytewise hashable
+    using Name = StaticVector<Letter, 4>;
+    Name upper = {{'A'}, {'B'}};
+    Name lower = {{'a'}, {'b'}};
+    ASSERT_EQ(upper, lower);
+    ASSERT_EQ(std::hash<Name>()(upper), std::hash<Name>()(lower));
+}
+
+template<typename V>
+concept has_spare_capacity = requires(V v) { v.spare_capacity(); };
+
+TEST(StaticVector, spare_capacity)
+{
+    StaticVector<std::byte, 16> buf;
+    buf.push_back(std::byte{1});
+
+    auto spare = buf.spare_capacity();
+    ASSERT_EQ(spare.size(), 15);
+    ASSERT_EQ(spare.data(), buf.data() + 1);
+
+    const char payload[] = "hello";
+    std::memcpy(spare.data(), payload, 5);
+    buf.commit(5);
+    ASSERT_EQ(buf.size(), 6);
+    ASSERT_EQ(buf[5], std::byte{'o'});
+    ASSERT_THROW(buf.commit(11), std::length_error);
+
+    buf.resize_for_overwrite(16);
+    ASSERT_EQ(buf.size(), 16);
+    ASSERT_TRUE(buf.spare_capacity().empty());
+    buf.resize_for_overwrite(2);
+    ASSERT_EQ(buf.size(), 2);
+    ASSERT_EQ(buf[1], std::byte{'h'});
+    ASSERT_THROW(buf.resize_for_overwrite(17), std::length_error);
+
+    static_assert(!has_spare_capacity<StaticVector<std::string, 4>>);
+}
+
+TEST(StaticVector, fixed_size_sources)
+{
+    const int raw[] = {1, 2, 3};
+    StaticVector<int, 8> from_raw(raw);
+    ASSERT_EQ(from_raw.size(), 3);
+    ASSERT_EQ(from_raw[2], 3);
+
+    std::array<std::string, 2> words = {"a", "b"};
+    StaticVector<std::string, 4> copied(words);
+    StaticVector<std::string, 4> moved(std::move(words));
+    ASSERT_EQ(copied, moved);
+    ASSERT_EQ(moved[1], "b");
+
+    StaticVector<std::string, 2> small = {"x", "y"};
+    StaticVector<std::string, 5> wide(small);
+    ASSERT_EQ(wide.size(), 2);
+    StaticVector<std::string, 5> taken(std::move(small));
+    ASSERT_EQ(taken[0], "x");
+    ASSERT_TRUE(small.empty());
+
+    StaticVector<char, 8> text("hi");
+    ASSERT_EQ(text.size(), 3);
+    ASSERT_EQ(text[2], '\0');
+
+    static_assert(std::is_constructible_v<StaticVector<int, 4>, const int (&)[4]>);
+    static_assert(std::is_constructible_v<StaticVector<int, 4>, StaticVector<int, 2>>);
+    static_assert(!std::is_constructible_v<StaticVector<int, 2>, const int (&)[4]>);
+    static_assert(!std::is_constructible_v<StaticVector<int, 2>, std::array<int, 5>>);
+    static_assert(!std::is_constructible_v<StaticVector<int, 2>, StaticVector<int, 4>>);
+}